@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CharacterPoolSubsystem.h"
+#include "TopDownCharacter.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CVarCharacterPoolStats(
+	TEXT("TopDown.CharacterPool.Stats"),
+	TEXT("Log character pool size and reuse counters for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCharacterPoolSubsystem* Pool = World ? World->GetSubsystem<UCharacterPoolSubsystem>() : nullptr)
+		{
+			Pool->LogStats();
+		}
+	})
+);
+
+bool UCharacterPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCharacterPoolSubsystem::Deinitialize()
+{
+	if (NumReuses + NumSpawns > 0)
+	{
+		LogStats();
+	}
+
+	PendingReleases.Empty();
+	FreeCharacters.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UCharacterPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterPoolSubsystem, STATGROUP_Tickables);
+}
+
+void UCharacterPoolSubsystem::Tick(float DeltaTime)
+{
+	if (PendingReleases.Num() == 0)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	int32 NumDue = 0;
+	while (NumDue < PendingReleases.Num() && PendingReleases[NumDue].ReleaseTime <= Now)
+	{
+		if (ATopDownCharacter* Character = PendingReleases[NumDue].Character.Get())
+		{
+			DeactivateCharacter(Character);
+		}
+		++NumDue;
+	}
+
+	if (NumDue > 0)
+	{
+		PendingReleases.RemoveAt(0, NumDue, EAllowShrinking::No);
+	}
+}
+
+// ========================================================================================
+// Pool Access
+// ========================================================================================
+
+ATopDownCharacter* UCharacterPoolSubsystem::AcquireCharacter(TSubclassOf<ATopDownCharacter> CharacterClass, const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* World = GetWorld();
+	if (!CharacterClass || !World || World->GetNetMode() == NM_Client)
+	{
+		return nullptr;
+	}
+
+	// Reuse a pooled character of exactly this class
+	for (int32 Index = FreeCharacters.Num() - 1; Index >= 0; --Index)
+	{
+		ATopDownCharacter* Character = FreeCharacters[Index];
+		if (!IsValid(Character))
+		{
+			FreeCharacters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Character->GetClass() == CharacterClass)
+		{
+			FreeCharacters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			Character->ActivateFromPool(Location, Rotation);
+			++NumReuses;
+			return Character;
+		}
+	}
+
+	// Pool empty for this class: pay for a full spawn
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	ATopDownCharacter* Character = World->SpawnActor<ATopDownCharacter>(CharacterClass, Location, Rotation, SpawnParams);
+	if (Character)
+	{
+		++NumSpawns;
+	}
+	return Character;
+}
+
+void UCharacterPoolSubsystem::ReleaseCharacter(ATopDownCharacter* Character)
+{
+	if (!IsValid(Character) || !Character->HasAuthority())
+	{
+		return;
+	}
+
+	FPendingRelease& Pending = PendingReleases.AddDefaulted_GetRef();
+	Pending.ReleaseTime = GetWorld()->GetTimeSeconds() + RagdollDuration;
+	Pending.Character = Character;
+}
+
+void UCharacterPoolSubsystem::DeactivateCharacter(ATopDownCharacter* Character)
+{
+	// Only still-dead characters that nobody has respawned into
+	if (!Character->IsDead() || Character->IsPooled())
+	{
+		return;
+	}
+
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->UnPossess();
+	}
+
+	if (FreeCharacters.Num() >= MaxPooledCharacters)
+	{
+		Character->Destroy();
+		++NumDestroyed;
+		return;
+	}
+
+	Character->DeactivateToPool();
+	FreeCharacters.Add(Character);
+}
+
+// ========================================================================================
+// Stats
+// ========================================================================================
+
+void UCharacterPoolSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Character pool: %d pooled, %d pending, %d reused, %d spawned, %d destroyed (pool full)"),
+	       FreeCharacters.Num(), PendingReleases.Num(), NumReuses, NumSpawns, NumDestroyed);
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CharacterPoolSubsystem.generated.h"
+
+class ATopDownCharacter;
+
+/**
+ * UCharacterPoolSubsystem
+ *
+ * World subsystem that recycles dead characters for respawns instead of
+ * destroying them and spawning a new pawn (server only).
+ *
+ * Features:
+ * - Dead characters keep their ragdoll for RagdollDuration, then are unpossessed,
+ *   hidden and made net dormant (ATopDownCharacter::DeactivateToPool)
+ * - Respawns take a pooled character of the right class and teleport it to the start
+ *   (ATopDownCharacter::ActivateFromPool), spawning only when the pool is empty
+ * - Reuse/spawn counters for sizing
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API UCharacterPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// ========================================================================================
+	// Pool Access
+	// ========================================================================================
+
+	/**
+	 * Get a character for a respawn, placed at the given transform
+	 * Reuses a pooled character of exactly this class, or spawns one if there is none
+	 * @param CharacterClass - Pawn class to hand out
+	 * @param Location - Spawn location
+	 * @param Rotation - Spawn rotation
+	 * @return Active character, or nullptr if one could not be spawned
+	 */
+	ATopDownCharacter* AcquireCharacter(TSubclassOf<ATopDownCharacter> CharacterClass, const FVector& Location, const FRotator& Rotation);
+
+	/**
+	 * Hand a dead character back; it enters the pool once its ragdoll window has passed
+	 * @param Character - Dead character (may still be possessed)
+	 */
+	void ReleaseCharacter(ATopDownCharacter* Character);
+
+	// ========================================================================================
+	// Stats
+	// ========================================================================================
+
+	/** Characters sitting in the pool, ready for reuse */
+	UFUNCTION(BlueprintPure, Category = "Character Pool")
+	int32 GetNumPooled() const { return FreeCharacters.Num(); }
+
+	/** Write pool counters to the log */
+	void LogStats() const;
+
+protected:
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Seconds a dead character stays visible (ragdoll) before it is pooled */
+	UPROPERTY(Config)
+	float RagdollDuration = 2.0f;
+
+	/** Upper bound on pooled characters (extra releases are destroyed) */
+	UPROPERTY(Config)
+	int32 MaxPooledCharacters = 128;
+
+private:
+	/** Dead character waiting out its ragdoll window */
+	struct FPendingRelease
+	{
+		float ReleaseTime;
+		TWeakObjectPtr<ATopDownCharacter> Character;
+	};
+
+	/** Unpossess and park a character, or destroy it if the pool is full */
+	void DeactivateCharacter(ATopDownCharacter* Character);
+
+	/** Releases in due-time order (constant delay, so appends stay sorted) */
+	TArray<FPendingRelease> PendingReleases;
+
+	/** Pooled characters */
+	UPROPERTY()
+	TArray<ATopDownCharacter*> FreeCharacters;
+
+	/** Counters */
+	int32 NumReuses = 0;
+	int32 NumSpawns = 0;
+	int32 NumDestroyed = 0;
+};
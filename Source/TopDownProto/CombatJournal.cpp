@@ -0,0 +1,492 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatJournal.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Compression.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarCombatJournalEnabled(
+	TEXT("TopDown.CombatJournal.Enabled"),
+	1,
+	TEXT("Record fires, hits, damage, deaths and respawns to Saved/CombatJournal. 0 = off"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommand CVarCombatJournalStats(
+	TEXT("TopDown.CombatJournal.Stats"),
+	TEXT("Log combat journal record, drop and compression counters"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatJournal::Get().LogStats();
+	})
+);
+
+namespace CombatJournal
+{
+	/** Records per compressed block (~64 KB raw) */
+	constexpr int32 BlockRecords = 2048;
+
+	/** Writer wakes at least this often to drain the rings */
+	constexpr uint32 WriterPeriodMs = 100;
+
+	/** Partial blocks are written once they are this old */
+	constexpr double MaxBlockAgeSeconds = 1.0;
+
+	/** Compression format (zlib so journals can also be read outside the engine) */
+	static const FName CompressionFormat = NAME_Zlib;
+}
+
+FCombatJournal& FCombatJournal::Get()
+{
+	static FCombatJournal Instance;
+	return Instance;
+}
+
+bool FCombatJournal::IsEnabled()
+{
+	return CVarCombatJournalEnabled.GetValueOnAnyThread() != 0;
+}
+
+FCombatJournal::FCombatJournal()
+{
+	PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FCombatJournal::Shutdown);
+}
+
+FCombatJournal::~FCombatJournal()
+{
+	FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+	Shutdown();
+}
+
+uint32 FCombatJournal::GetJournalId(const UObject* Object)
+{
+	const APlayerState* PlayerState = nullptr;
+	if (const APawn* Pawn = Cast<APawn>(Object))
+	{
+		PlayerState = Pawn->GetPlayerState();
+	}
+	else if (const AController* Controller = Cast<AController>(Object))
+	{
+		PlayerState = Controller->PlayerState;
+	}
+	else
+	{
+		PlayerState = Cast<APlayerState>(Object);
+	}
+
+	if (PlayerState)
+	{
+		return static_cast<uint32>(PlayerState->GetPlayerId()) & 0x7FFFFFFF;
+	}
+	return Object ? (Object->GetUniqueID() | 0x80000000) : 0;
+}
+
+// ========================================================================================
+// Recording (any thread)
+// ========================================================================================
+
+FCombatJournal::FThreadBuffer& FCombatJournal::GetThreadBuffer()
+{
+	static thread_local FThreadBuffer* ThreadBuffer = nullptr;
+	if (!ThreadBuffer)
+	{
+		FScopeLock Lock(&ThreadBuffersLock);
+		ThreadBuffer = ThreadBuffers.Add_GetRef(MakeUnique<FThreadBuffer>()).Get();
+	}
+	return *ThreadBuffer;
+}
+
+void FCombatJournal::Record(ECombatJournalEvent Type, const UObject* Source, const UObject* Target, const FVector& Location, float Value)
+{
+	if (!IsEnabled() || bStopping.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	if (!bWriterStarted.load(std::memory_order_acquire))
+	{
+		StartWriter();
+	}
+
+	FThreadBuffer& Buffer = GetThreadBuffer();
+	const uint32 Head = Buffer.Head.load(std::memory_order_relaxed);
+	const uint32 Tail = Buffer.Tail.load(std::memory_order_acquire);
+	if (Head - Tail >= FThreadBuffer::Capacity)
+	{
+		// Writer is a whole ring behind - drop rather than block the game
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const uint32 Slot = Head & (FThreadBuffer::Capacity - 1);
+	Buffer.Seconds[Slot] = FPlatformTime::Seconds();
+
+	FCombatJournalRecord& Entry = Buffer.Records[Slot];
+	Entry.Time = 0.0f;
+	Entry.Type = static_cast<uint8>(Type);
+	Entry.Padding[0] = Entry.Padding[1] = Entry.Padding[2] = 0;
+	Entry.SourceId = GetJournalId(Source);
+	Entry.TargetId = GetJournalId(Target);
+	Entry.Location = FVector3f(Location);
+	Entry.Value = Value;
+
+	Buffer.Head.store(Head + 1, std::memory_order_release);
+	NumRecorded.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FCombatJournal::BeginJournal(const FString& MatchName)
+{
+	if (!IsEnabled() || bStopping.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	{
+		FScopeLock Lock(&FileLock);
+		RequestedFileStartSeconds = FPlatformTime::Seconds();
+		RequestedMatchName = MatchName;
+
+		// Everything recorded up to here belongs to the previous file
+		RequestedHeads.Reset();
+		{
+			FScopeLock BuffersLock(&ThreadBuffersLock);
+			for (const TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+			{
+				RequestedHeads.Add(Buffer->Head.load(std::memory_order_acquire));
+			}
+		}
+
+		RequestedFileIndex.fetch_add(1, std::memory_order_release);
+	}
+
+	if (!bWriterStarted.load(std::memory_order_acquire))
+	{
+		StartWriter();
+	}
+	else
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+// ========================================================================================
+// Writer Thread
+// ========================================================================================
+
+void FCombatJournal::StartWriter()
+{
+	FScopeLock Lock(&StartLock);
+	if (bWriterStarted.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	// Recording outside a TopDown match: journal from the first record
+	{
+		FScopeLock FileScopeLock(&FileLock);
+		if (RequestedFileIndex.load(std::memory_order_relaxed) == 0)
+		{
+			RequestedFileStartSeconds = FPlatformTime::Seconds();
+			RequestedHeads.Reset();
+			RequestedFileIndex.store(1, std::memory_order_release);
+		}
+	}
+
+	// The file itself is opened by the writer thread
+	PendingBlock.Reserve(CombatJournal::BlockRecords);
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	WriterThread = FRunnableThread::Create(this, TEXT("CombatJournalWriter"), 0, TPri_BelowNormal);
+
+	bWriterStarted.store(true, std::memory_order_release);
+}
+
+void FCombatJournal::RotateFileIfRequested()
+{
+	const uint32 RequestedIndex = RequestedFileIndex.load(std::memory_order_acquire);
+	if (RequestedIndex == OpenFileIndex)
+	{
+		return;
+	}
+
+	// Everything recorded before the request belongs to the previous match (Drain stops at the request)
+	if (FileWriter)
+	{
+		while (Drain() > 0 || PendingBlock.Num() > 0)
+		{
+			WriteBlock();
+		}
+		FileWriter->Close();
+		FileWriter.Reset();
+	}
+
+	FString MatchName;
+	{
+		FScopeLock Lock(&FileLock);
+		FileStartSeconds = RequestedFileStartSeconds;
+		MatchName = RequestedMatchName;
+	}
+	OpenFileIndex = RequestedIndex;
+
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("CombatJournal");
+	const FString BaseName = MatchName.IsEmpty()
+		? FString::Printf(TEXT("Journal_%s"), *FDateTime::Now().ToString())
+		: FString::Printf(TEXT("Journal_%s_%s"), *FDateTime::Now().ToString(), *FPaths::MakeValidFileName(MatchName));
+	FString NewFilePath = Directory / BaseName + TEXT(".tdj");
+	for (int32 Suffix = 1; IFileManager::Get().FileExists(*NewFilePath); ++Suffix)
+	{
+		// Two matches started within the same second
+		NewFilePath = Directory / FString::Printf(TEXT("%s_%d.tdj"), *BaseName, Suffix);
+	}
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*NewFilePath));
+	if (FileWriter)
+	{
+		uint32 Magic = CombatJournalFormat::Magic;
+		uint32 Version = CombatJournalFormat::Version;
+		uint32 RecordSize = sizeof(FCombatJournalRecord);
+		int64 StartTicks = (FDateTime::UtcNow() - FTimespan::FromSeconds(FPlatformTime::Seconds() - FileStartSeconds)).GetTicks();
+		*FileWriter << Magic << Version << RecordSize << StartTicks;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Combat journal: could not open %s"), *NewFilePath);
+	}
+
+	FScopeLock Lock(&FileLock);
+	FilePath = MoveTemp(NewFilePath);
+}
+
+uint32 FCombatJournal::Run()
+{
+	double BlockStartTime = FPlatformTime::Seconds();
+
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		RotateFileIfRequested();
+		WakeEvent->Wait(CombatJournal::WriterPeriodMs);
+
+		Drain();
+		if (PendingBlock.Num() >= CombatJournal::BlockRecords
+			|| (PendingBlock.Num() > 0 && FPlatformTime::Seconds() - BlockStartTime >= CombatJournal::MaxBlockAgeSeconds))
+		{
+			WriteBlock();
+			BlockStartTime = FPlatformTime::Seconds();
+		}
+	}
+
+	// Final flush: everything recorded before Stop(), in the file it belongs to
+	RotateFileIfRequested();
+	while (Drain() > 0 || PendingBlock.Num() > 0)
+	{
+		WriteBlock();
+	}
+
+	if (FileWriter)
+	{
+		FileWriter->Close();
+		FileWriter.Reset();
+	}
+	return 0;
+}
+
+void FCombatJournal::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FCombatJournal::Shutdown()
+{
+	if (!WriterThread)
+	{
+		return;
+	}
+
+	Stop();
+	WriterThread->WaitForCompletion();
+	delete WriterThread;
+	WriterThread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	LogStats();
+}
+
+int32 FCombatJournal::Drain()
+{
+	// Heads are read under FileLock so a BeginJournal can't land between the check and the reads
+	TArray<FThreadBuffer*, TInlineAllocator<16>> Buffers;
+	TArray<uint32, TInlineAllocator<16>> DrainHeads;
+	{
+		FScopeLock FileScopeLock(&FileLock);
+		FScopeLock Lock(&ThreadBuffersLock);
+
+		const bool bRotationPending = FileWriter && RequestedFileIndex.load(std::memory_order_relaxed) != OpenFileIndex;
+		for (int32 BufferIndex = 0; BufferIndex < ThreadBuffers.Num(); ++BufferIndex)
+		{
+			FThreadBuffer* Buffer = ThreadBuffers[BufferIndex].Get();
+			Buffers.Add(Buffer);
+			if (!bRotationPending)
+			{
+				DrainHeads.Add(Buffer->Head.load(std::memory_order_acquire));
+			}
+			else
+			{
+				// The previous file only gets what was recorded before the request
+				DrainHeads.Add(RequestedHeads.IsValidIndex(BufferIndex) ? RequestedHeads[BufferIndex] : Buffer->Tail.load(std::memory_order_relaxed));
+			}
+		}
+	}
+
+	int32 NumDrained = 0;
+	for (int32 BufferIndex = 0; BufferIndex < Buffers.Num(); ++BufferIndex)
+	{
+		FThreadBuffer* Buffer = Buffers[BufferIndex];
+		const uint32 Tail = Buffer->Tail.load(std::memory_order_relaxed);
+		const uint32 Available = FMath::Min<uint32>(DrainHeads[BufferIndex] - Tail, CombatJournal::BlockRecords - PendingBlock.Num());
+
+		for (uint32 Offset = 0; Offset < Available; ++Offset)
+		{
+			const uint32 Slot = (Tail + Offset) & (FThreadBuffer::Capacity - 1);
+			FCombatJournalRecord& Entry = PendingBlock.Add_GetRef(Buffer->Records[Slot]);
+			Entry.Time = static_cast<float>(Buffer->Seconds[Slot] - FileStartSeconds);
+		}
+		Buffer->Tail.store(Tail + Available, std::memory_order_release);
+		NumDrained += Available;
+
+		if (PendingBlock.Num() >= CombatJournal::BlockRecords)
+		{
+			break;
+		}
+	}
+	return NumDrained;
+}
+
+void FCombatJournal::WriteBlock()
+{
+	if (PendingBlock.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 RawSize = PendingBlock.Num() * sizeof(FCombatJournalRecord);
+	int32 CompressedSize = FCompression::CompressMemoryBound(CombatJournal::CompressionFormat, RawSize);
+	CompressedBlock.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+
+	if (FileWriter && FCompression::CompressMemory(CombatJournal::CompressionFormat, CompressedBlock.GetData(), CompressedSize, PendingBlock.GetData(), RawSize))
+	{
+		uint32 BlockSize = static_cast<uint32>(CompressedSize);
+		uint32 NumRecords = static_cast<uint32>(PendingBlock.Num());
+		*FileWriter << BlockSize << NumRecords;
+		FileWriter->Serialize(CompressedBlock.GetData(), CompressedSize);
+		FileWriter->Flush();
+
+		NumBlocks.fetch_add(1, std::memory_order_relaxed);
+		NumBytesWritten.fetch_add(CompressedSize + 2 * sizeof(uint32), std::memory_order_relaxed);
+	}
+
+	PendingBlock.Reset();
+}
+
+void FCombatJournal::LogStats() const
+{
+	const uint64 Recorded = NumRecorded.load(std::memory_order_relaxed);
+	const uint64 BytesWritten = NumBytesWritten.load(std::memory_order_relaxed);
+	int32 NumThreads = 0;
+	{
+		FScopeLock Lock(&ThreadBuffersLock);
+		NumThreads = ThreadBuffers.Num();
+	}
+	FString CurrentFilePath;
+	{
+		FScopeLock Lock(&FileLock);
+		CurrentFilePath = FilePath;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Combat journal: %llu recorded, %llu dropped, %llu blocks, %llu bytes (%.1f bytes/record) from %d threads -> %s"),
+	       Recorded, NumDropped.load(std::memory_order_relaxed), NumBlocks.load(std::memory_order_relaxed), BytesWritten,
+	       Recorded > 0 ? static_cast<double>(BytesWritten) / Recorded : 0.0, NumThreads, *CurrentFilePath);
+}
+
+// ========================================================================================
+// Reader
+// ========================================================================================
+
+bool FCombatJournalReader::Load(const FString& Path, TArray<FCombatJournalRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 RecordSize = 0;
+	int64 StartTicks = 0;
+	*Reader << Magic << Version << RecordSize << StartTicks;
+	if (Reader->IsError() || Magic != CombatJournalFormat::Magic || Version != CombatJournalFormat::Version
+		|| RecordSize != sizeof(FCombatJournalRecord))
+	{
+		return false;
+	}
+	StartTimeUtc = FDateTime(StartTicks);
+
+	TArray<uint8> Compressed;
+	while (Reader->Tell() + 2 * static_cast<int64>(sizeof(uint32)) <= Reader->TotalSize())
+	{
+		uint32 BlockSize = 0;
+		uint32 NumRecords = 0;
+		*Reader << BlockSize << NumRecords;
+		if (Reader->Tell() + BlockSize > Reader->TotalSize())
+		{
+			break;  // Server stopped mid-block
+		}
+		if (NumRecords == 0)
+		{
+			Reader->Seek(Reader->Tell() + BlockSize);
+			continue;
+		}
+
+		Compressed.SetNumUninitialized(BlockSize);
+		Reader->Serialize(Compressed.GetData(), BlockSize);
+
+		const int32 FirstRecord = OutRecords.AddUninitialized(NumRecords);
+		if (!FCompression::UncompressMemory(CombatJournal::CompressionFormat, &OutRecords[FirstRecord], NumRecords * sizeof(FCombatJournalRecord),
+		                                    Compressed.GetData(), BlockSize))
+		{
+			OutRecords.SetNum(FirstRecord);
+			break;
+		}
+	}
+
+	return true;
+}
+
+const TCHAR* FCombatJournalReader::GetEventName(uint8 Type)
+{
+	switch (static_cast<ECombatJournalEvent>(Type))
+	{
+	case ECombatJournalEvent::Fire:     return TEXT("Fire");
+	case ECombatJournalEvent::Hit:      return TEXT("Hit");
+	case ECombatJournalEvent::Damage:   return TEXT("Damage");
+	case ECombatJournalEvent::Death:    return TEXT("Death");
+	case ECombatJournalEvent::Respawn:  return TEXT("Respawn");
+	default:                            return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+
+/** Combat journal event kinds */
+enum class ECombatJournalEvent : uint8
+{
+	Fire,           // Source fired; Location = muzzle
+	Hit,            // Source's projectile hit Target; Location = impact, Value = projectile damage
+	Damage,         // Target took Value damage from Source; Location = target
+	Death,          // Target died, Source = killer; Location = target
+	Respawn         // Target respawned; Location = spawn point
+};
+
+/**
+ * FCombatJournalRecord
+ *
+ * Fixed-size journal record (32 bytes), written to disk as-is.
+ * Players are identified by PlayerState PlayerId; anything without a player state by its
+ * UObject unique id with the top bit set (see FCombatJournal::GetJournalId).
+ */
+struct FCombatJournalRecord
+{
+	float Time;             // Seconds since this journal file started
+	uint8 Type;             // ECombatJournalEvent
+	uint8 Padding[3];
+	uint32 SourceId;        // Shooter / instigator / killer
+	uint32 TargetId;        // Hit, damaged, killed or respawned actor (0 for fire)
+	FVector3f Location;
+	float Value;
+};
+static_assert(sizeof(FCombatJournalRecord) == 32, "Journal records are written to disk as-is");
+
+/**
+ * Journal file layout (little endian)
+ *   Header: Magic 'TDCJ', Version, RecordSize, StartTimeUtc (FDateTime ticks, int64)
+ *   Blocks: CompressedSize (uint32), NumRecords (uint32), zlib data of NumRecords records
+ */
+namespace CombatJournalFormat
+{
+	constexpr uint32 Magic = 0x4A434454;    // 'TDCJ'
+	constexpr uint32 Version = 1;
+}
+
+/**
+ * FCombatJournal
+ *
+ * Match-long record of fires, hits, damage, deaths and respawns for post-match analysis
+ * and dispute handling, at a fraction of the cost of a demo recording.
+ *
+ * Features:
+ * - Record() writes one 32-byte record and its timestamp into a single-producer ring owned by the
+ *   calling thread (no locks, no allocation, no I/O); a full ring drops and counts the record
+ * - Timestamps stay in double seconds until written, then become a float offset from the file's start,
+ *   so records keep sub-millisecond precision however long the server has been up
+ * - A writer thread drains every ring, compresses blocks with zlib and appends them to
+ *   Saved/CombatJournal/Journal_<date>_<match>.tdj; files are opened and rotated on that thread
+ * - One file per match: the game mode calls BeginJournal at match start, which marks every ring's
+ *   position; the writer finishes the previous file up to those marks, then opens the next one
+ * - FCombatJournalReader loads a journal back; the CombatJournalDump commandlet prints one
+ * - TopDown.CombatJournal.Enabled toggles recording, TopDown.CombatJournal.Stats logs counters
+ */
+class TOPDOWNPROTO_API FCombatJournal : public FRunnable
+{
+public:
+	static FCombatJournal& Get();
+
+	/** Is recording enabled (TopDown.CombatJournal.Enabled)? */
+	static bool IsEnabled();
+
+	/**
+	 * Append an event (any thread)
+	 * @param Type - Event kind
+	 * @param Source - Shooter, instigator or killer (pawn, controller or other actor; may be null)
+	 * @param Target - Hit, damaged, killed or respawned actor (may be null)
+	 * @param Location - Where it happened
+	 * @param Value - Damage, if any
+	 */
+	void Record(ECombatJournalEvent Type, const UObject* Source, const UObject* Target, const FVector& Location, float Value = 0.0f);
+
+	/**
+	 * Start a new journal file (game thread, at match start); starts the writer if needed
+	 * @param MatchName - Tag for the file name, e.g. the map
+	 */
+	void BeginJournal(const FString& MatchName);
+
+	/** Stable id of an object in the journal: PlayerId for players and their pawns, else unique id | 0x80000000 */
+	static uint32 GetJournalId(const UObject* Object);
+
+	/** Stop the writer, flushing everything recorded so far */
+	void Shutdown();
+
+	/** Write journal counters to the log */
+	void LogStats() const;
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	FCombatJournal();
+	virtual ~FCombatJournal() override;
+
+	/** Single-producer (owning thread) / single-consumer (writer thread) ring */
+	struct FThreadBuffer
+	{
+		static constexpr uint32 Capacity = 4096;    // Power of two, ~160 KB
+
+		FCombatJournalRecord Records[Capacity];     // Time is filled in by the writer
+		double Seconds[Capacity];                   // FPlatformTime::Seconds() of each record
+		std::atomic<uint32> Head{0};                // Next slot the owner writes
+		std::atomic<uint32> Tail{0};                // Next slot the writer reads
+	};
+
+	/** The calling thread's ring, registered on first use */
+	FThreadBuffer& GetThreadBuffer();
+
+	/** Start the writer thread (BeginJournal, or the first Record outside a TopDown match) */
+	void StartWriter();
+
+	/** Close the current file and open the requested one, if BeginJournal asked for a new one (writer thread) */
+	void RotateFileIfRequested();
+
+	/**
+	 * Move ring records into PendingBlock, timed from the open file's start (writer thread)
+	 * While a new file is requested, only records made before the request are moved
+	 * @return Number of records moved
+	 */
+	int32 Drain();
+
+	/** Compress and append PendingBlock to the file (writer thread) */
+	void WriteBlock();
+
+	/** Every thread's ring (registration only; rings are never freed while the journal lives) */
+	TArray<TUniquePtr<FThreadBuffer>> ThreadBuffers;
+	mutable FCriticalSection ThreadBuffersLock;
+
+	/** Writer thread state */
+	FRunnableThread* WriterThread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{false};
+	std::atomic<bool> bWriterStarted{false};
+	FCriticalSection StartLock;
+
+	/** Writer-side scratch (writer thread only) */
+	TArray<FCombatJournalRecord> PendingBlock;
+	TArray<uint8> CompressedBlock;
+	TUniquePtr<FArchive> FileWriter;
+	uint32 OpenFileIndex = 0;
+	double FileStartSeconds = 0.0;
+
+	/**
+	 * File requested by BeginJournal (index 0 = none yet), each ring's head at the request
+	 * (rings registered later start in the new file) and the path of the open file
+	 */
+	std::atomic<uint32> RequestedFileIndex{0};
+	double RequestedFileStartSeconds = 0.0;
+	FString RequestedMatchName;
+	TArray<uint32> RequestedHeads;
+	FString FilePath;
+	mutable FCriticalSection FileLock;     // Taken before ThreadBuffersLock when both are needed
+
+	/** Counters */
+	std::atomic<uint64> NumRecorded{0};
+	std::atomic<uint64> NumDropped{0};
+	std::atomic<uint64> NumBlocks{0};
+	std::atomic<uint64> NumBytesWritten{0};
+
+	FDelegateHandle PreExitHandle;
+};
+
+/**
+ * FCombatJournalReader
+ *
+ * Loads a journal file written by FCombatJournal.
+ */
+class TOPDOWNPROTO_API FCombatJournalReader
+{
+public:
+	/**
+	 * Read and decompress a whole journal
+	 * @param Path - Journal file
+	 * @param OutRecords - Records in write order per thread, block by block
+	 * @return False if the file is missing, not a journal or truncated mid-header
+	 *         (a truncated final block is dropped and the rest is still returned)
+	 */
+	bool Load(const FString& Path, TArray<FCombatJournalRecord>& OutRecords);
+
+	/** Wall-clock UTC time the journal started (valid after Load) */
+	FDateTime GetStartTimeUtc() const { return StartTimeUtc; }
+
+	/** Display name of an event type */
+	static const TCHAR* GetEventName(uint8 Type);
+
+private:
+	FDateTime StartTimeUtc;
+};
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatJournalDumpCommandlet.h"
+#include "CombatJournal.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+
+UCombatJournalDumpCommandlet::UCombatJournalDumpCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatJournalDumpCommandlet::Main(const FString& Params)
+{
+	FString FilePath;
+	if (!FParse::Value(*Params, TEXT("file="), FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=CombatJournalDump -file=<journal.tdj> [-csv=<out.csv>] [-player=<id>] [-type=<event>]"));
+		return 1;
+	}
+
+	FCombatJournalReader Reader;
+	TArray<FCombatJournalRecord> Records;
+	if (!Reader.Load(FilePath, Records))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Combat journal: could not read %s"), *FilePath);
+		return 1;
+	}
+
+	uint32 PlayerFilter = 0;
+	const bool bFilterPlayer = FParse::Value(*Params, TEXT("player="), PlayerFilter);
+	FString TypeFilter;
+	FParse::Value(*Params, TEXT("type="), TypeFilter);
+	FString CsvPath;
+	const bool bWriteCsv = FParse::Value(*Params, TEXT("csv="), CsvPath);
+
+	TArray<FString> CsvLines;
+	if (bWriteCsv)
+	{
+		CsvLines.Add(TEXT("Time,Event,Source,Target,X,Y,Z,Value"));
+	}
+
+	int32 EventCounts[5] = {};
+	for (const FCombatJournalRecord& Record : Records)
+	{
+		const TCHAR* EventName = FCombatJournalReader::GetEventName(Record.Type);
+		if (bFilterPlayer && Record.SourceId != PlayerFilter && Record.TargetId != PlayerFilter)
+		{
+			continue;
+		}
+		if (!TypeFilter.IsEmpty() && TypeFilter != EventName)
+		{
+			continue;
+		}
+
+		if (Record.Type < UE_ARRAY_COUNT(EventCounts))
+		{
+			++EventCounts[Record.Type];
+		}
+
+		if (bWriteCsv)
+		{
+			CsvLines.Add(FString::Printf(TEXT("%.4f,%s,%u,%u,%.1f,%.1f,%.1f,%.2f"), Record.Time, EventName, Record.SourceId, Record.TargetId,
+			                             Record.Location.X, Record.Location.Y, Record.Location.Z, Record.Value));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("%9.3f %-8s %10u -> %10u at (%.0f, %.0f, %.0f) %.1f"), Record.Time, EventName, Record.SourceId, Record.TargetId,
+			       Record.Location.X, Record.Location.Y, Record.Location.Z, Record.Value);
+		}
+	}
+
+	if (bWriteCsv && !FFileHelper::SaveStringArrayToFile(CsvLines, *CsvPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Combat journal: could not write %s"), *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Combat journal %s (started %s UTC): %d records - %d fire, %d hit, %d damage, %d death, %d respawn"),
+	       *FilePath, *Reader.GetStartTimeUtc().ToString(), Records.Num(), EventCounts[0], EventCounts[1], EventCounts[2], EventCounts[3], EventCounts[4]);
+	return 0;
+}
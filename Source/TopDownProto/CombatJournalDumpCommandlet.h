@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatJournalDumpCommandlet.generated.h"
+
+/**
+ * UCombatJournalDumpCommandlet
+ *
+ * Prints a combat journal written by FCombatJournal:
+ *   UnrealEditor-Cmd TopDownProto -run=CombatJournalDump -file=<journal.tdj> [-csv=<out.csv>] [-player=<id>] [-type=<Hit>]
+ *
+ * Features:
+ * - One line per record (time, event, source, target, location, value) to the log, or a CSV file
+ * - Optional filters on a player id (as source or target) and on an event type
+ * - Per-event totals at the end
+ */
+UCLASS()
+class UCombatJournalDumpCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCombatJournalDumpCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CosmeticEventSubsystem.h"
+#include "TopDownStats.h"
+#include "TopDownPlayerController.h"
+#include "TopDownCharacter.h"
+#include "Projectile.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CVarCosmeticEventStats(
+	TEXT("TopDown.CosmeticEvents.Stats"),
+	TEXT("Log cosmetic event delivery counters for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCosmeticEventSubsystem* CosmeticEvents = World ? World->GetSubsystem<UCosmeticEventSubsystem>() : nullptr)
+		{
+			CosmeticEvents->LogStats();
+		}
+	})
+);
+
+bool UCosmeticEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCosmeticEventSubsystem::Deinitialize()
+{
+	if (NumQueued > 0)
+	{
+		LogStats();
+	}
+	PendingEvents.Empty();
+	Batch.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UCosmeticEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCosmeticEventSubsystem, STATGROUP_Tickables);
+}
+
+void UCosmeticEventSubsystem::QueueEvent(ECosmeticEventType Type, UClass* SourceClass, const FVector& Location, const FVector& Direction, const APawn* PredictedBy)
+{
+	// Clients play effects they receive, they never originate them
+	if (!SourceClass || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FCosmeticEvent& Event = PendingEvents.AddDefaulted_GetRef();
+	Event.Type = Type;
+	Event.SourceClass = SourceClass;
+	Event.Location = Location;
+	Event.Direction = Direction.GetSafeNormal();
+	Event.PredictedBy = PredictedBy;
+
+	NumQueued++;
+}
+
+void UCosmeticEventSubsystem::Tick(float DeltaTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(CosmeticEventFlush);
+
+	Super::Tick(DeltaTime);
+
+	if (PendingEvents.Num() == 0)
+	{
+		return;
+	}
+
+	const float CullDistanceSq = CullDistance * CullDistance;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		ATopDownPlayerController* PC = Cast<ATopDownPlayerController>(Iterator->Get());
+		if (!PC)
+		{
+			continue;
+		}
+
+		// Only what this client can plausibly see
+		const FVector ViewLocation = PC->GetFocalLocation();
+
+		// A remote client's own predicted events (a local controller never predicts)
+		const APawn* PredictingPawn = PC->IsLocalController() ? nullptr : PC->GetPawn();
+
+		Batch.Reset();
+		for (const FCosmeticEvent& Event : PendingEvents)
+		{
+			if (Event.PredictedBy && Event.PredictedBy == PredictingPawn)
+			{
+				NumPredicted++;
+				continue;
+			}
+
+			if (FVector::DistSquared2D(Event.Location, ViewLocation) > CullDistanceSq)
+			{
+				NumCulled++;
+				continue;
+			}
+
+			if (Batch.Num() >= MaxEventsPerBatch)
+			{
+				NumCulled++;
+				continue;
+			}
+
+			Batch.Add(Event);
+		}
+
+		if (Batch.Num() > 0)
+		{
+			// Local controllers (listen server host) execute this directly
+			PC->ClientReceiveCosmeticEvents(Batch);
+			NumSent += Batch.Num();
+			NumBatches++;
+		}
+	}
+
+	PendingEvents.Reset();
+}
+
+void UCosmeticEventSubsystem::PlayEvent(UWorld* World, const FCosmeticEvent& Event)
+{
+#if !UE_SERVER
+	if (!World || !Event.SourceClass || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	switch (Event.Type)
+	{
+	case ECosmeticEventType::Muzzle:
+		if (const ATopDownCharacter* Shooter = Cast<ATopDownCharacter>(Event.SourceClass->GetDefaultObject()))
+		{
+			Shooter->PlayFireEffects(World, Event.Location, Event.Direction);
+		}
+		break;
+	case ECosmeticEventType::Impact:
+		if (const AProjectile* Projectile = Cast<AProjectile>(Event.SourceClass->GetDefaultObject()))
+		{
+			Projectile->PlayHitEffects(World, Event.Location, Event.Direction);
+		}
+		break;
+	}
+#endif
+}
+
+void UCosmeticEventSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Cosmetic events: %lld queued, %lld sent in %lld batches, %lld culled, %lld predicted by their owner"),
+	       NumQueued, NumSent, NumBatches, NumCulled, NumPredicted);
+}
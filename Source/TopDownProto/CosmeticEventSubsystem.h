@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CosmeticEventSubsystem.generated.h"
+
+class APawn;
+
+/**
+ * ECosmeticEventType
+ *
+ * Kinds of purely visual/audio events sent to clients
+ */
+UENUM()
+enum class ECosmeticEventType : uint8
+{
+	Muzzle,
+	Impact
+};
+
+/**
+ * FCosmeticEvent
+ *
+ * Single cosmetic event. Effect assets are looked up on the source class defaults,
+ * so only the class (a stable net GUID) travels on the wire.
+ */
+USTRUCT()
+struct FCosmeticEvent
+{
+	GENERATED_BODY()
+
+	/** What happened */
+	UPROPERTY()
+	ECosmeticEventType Type = ECosmeticEventType::Muzzle;
+
+	/** Class whose defaults hold the effect assets (character for Muzzle, projectile for Impact) */
+	UPROPERTY()
+	UClass* SourceClass = nullptr;
+
+	/** Muzzle or impact location */
+	UPROPERTY()
+	FVector_NetQuantize Location;
+
+	/** Fire direction (Muzzle) or surface normal (Impact) */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	/** Pawn whose owning client already played this event locally (server only, not replicated) */
+	const APawn* PredictedBy = nullptr;
+};
+
+/**
+ * UCosmeticEventSubsystem
+ *
+ * Server-side queue for muzzle and impact effects.
+ *
+ * Features:
+ * - Events are queued during the frame and flushed once per frame
+ * - One unreliable client RPC per connection carrying the whole batch
+ * - Events are culled by distance from each client's view target
+ * - Events a client predicted (its own muzzle flash) are not sent back to it
+ * - Effect playback is compiled out of server builds
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API UCosmeticEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Queue a cosmetic event for delivery at the end of the frame (server only, ignored on clients)
+	 * @param Type - What happened
+	 * @param SourceClass - Class whose defaults hold the effect assets
+	 * @param Location - Where it happened
+	 * @param Direction - Fire direction or surface normal
+	 * @param PredictedBy - Pawn whose remote owning client already played the event (skipped for that client)
+	 */
+	void QueueEvent(ECosmeticEventType Type, UClass* SourceClass, const FVector& Location, const FVector& Direction, const APawn* PredictedBy = nullptr);
+
+	/** Play a received event locally (no-op in server builds) */
+	static void PlayEvent(UWorld* World, const FCosmeticEvent& Event);
+
+	/** Write delivery counters to the log */
+	void LogStats() const;
+
+protected:
+	/** Events further than this (2D) from a client's view target are not sent to that client */
+	UPROPERTY(Config)
+	float CullDistance = 5000.0f;
+
+	/** Upper bound on events per client per frame (extra events are dropped) */
+	UPROPERTY(Config)
+	int32 MaxEventsPerBatch = 64;
+
+private:
+	/** Events queued this frame */
+	TArray<FCosmeticEvent> PendingEvents;
+
+	/** Per-connection scratch batch */
+	TArray<FCosmeticEvent> Batch;
+
+	/** Delivery counters */
+	int64 NumQueued = 0;
+	int64 NumSent = 0;
+	int64 NumCulled = 0;
+	int64 NumPredicted = 0;
+	int64 NumBatches = 0;
+};
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DamageAggregationSubsystem.h"
+#include "TopDownCharacter.h"
+#include "TopDownStats.h"
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarDamageAggregate(
+	TEXT("TopDown.Damage.Aggregate"),
+	1,
+	TEXT("Accumulate hits per victim and resolve them once per frame. 0 = apply every hit immediately"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorld CVarDamageAggregationStats(
+	TEXT("TopDown.Damage.Stats"),
+	TEXT("Log damage aggregation counters for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UDamageAggregationSubsystem* DamageAggregation = World ? World->GetSubsystem<UDamageAggregationSubsystem>() : nullptr)
+		{
+			DamageAggregation->LogStats();
+		}
+	})
+);
+
+bool UDamageAggregationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamageAggregationSubsystem::Deinitialize()
+{
+	if (NumHitsQueued > 0)
+	{
+		LogStats();
+	}
+	PendingVictims.Empty();
+	PendingVictimIndices.Empty();
+	ResolvingVictims.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDamageAggregationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageAggregationSubsystem, STATGROUP_Tickables);
+}
+
+void UDamageAggregationSubsystem::QueueDamage(AActor* Victim, float Damage, AController* Instigator, AActor* Causer, TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if (!Victim || Damage == 0.0f || !Victim->HasAuthority())
+	{
+		return;
+	}
+
+	if (!DamageTypeClass)
+	{
+		DamageTypeClass = UDamageType::StaticClass();
+	}
+
+	if (CVarDamageAggregate.GetValueOnGameThread() == 0)
+	{
+		UGameplayStatics::ApplyDamage(Victim, Damage, Instigator, Causer, DamageTypeClass);
+		return;
+	}
+
+	int32& VictimIndex = PendingVictimIndices.FindOrAdd(Victim, INDEX_NONE);
+	if (VictimIndex == INDEX_NONE)
+	{
+		VictimIndex = PendingVictims.Num();
+		PendingVictims.AddDefaulted_GetRef().Victim = Victim;
+	}
+
+	FDamageContribution& Contribution = PendingVictims[VictimIndex].Contributions.AddDefaulted_GetRef();
+	Contribution.Instigator = Instigator;
+	Contribution.Causer = Causer;
+	Contribution.DamageTypeClass = DamageTypeClass;
+	Contribution.Damage = Damage;
+
+	NumHitsQueued++;
+}
+
+void UDamageAggregationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingVictims.Num() > 0)
+	{
+		ResolvePendingDamage();
+	}
+}
+
+void UDamageAggregationSubsystem::ResolvePendingDamage()
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(DamageResolve);
+
+	// Damage, death and respawn handlers may queue more hits; those go to the next pass
+	Swap(ResolvingVictims, PendingVictims);
+	PendingVictimIndices.Reset();
+
+	for (FPendingVictim& Pending : ResolvingVictims)
+	{
+		AActor* Victim = Pending.Victim.Get();
+		if (!Victim)
+		{
+			continue;
+		}
+
+		if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(Victim))
+		{
+			Character->TakeDamageBatch(Pending.Contributions);
+		}
+		else
+		{
+			for (const FDamageContribution& Contribution : Pending.Contributions)
+			{
+				UGameplayStatics::ApplyDamage(Victim, Contribution.Damage, Contribution.Instigator.Get(), Contribution.Causer.Get(), Contribution.DamageTypeClass);
+			}
+		}
+	}
+
+	TOPDOWN_INC_COUNTER(DamageVictims, ResolvingVictims.Num());
+	NumVictimsResolved += ResolvingVictims.Num();
+	NumResolvePasses++;
+
+	ResolvingVictims.Reset();
+}
+
+void UDamageAggregationSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Damage aggregation: %lld hits on %lld victims in %lld passes (%.2f hits/victim)"),
+	       NumHitsQueued, NumVictimsResolved, NumResolvePasses,
+	       NumVictimsResolved > 0 ? static_cast<double>(NumHitsQueued) / NumVictimsResolved : 0.0);
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
+#include "DamageAggregationSubsystem.generated.h"
+
+class UDamageType;
+
+/**
+ * FDamageContribution
+ *
+ * One hit on a victim, kept per instigator so kill credit survives aggregation
+ */
+struct FDamageContribution
+{
+	/** Controller credited with the damage */
+	TWeakObjectPtr<AController> Instigator;
+
+	/** Actor that caused the damage (projectile or shooter; may be gone by resolve time) */
+	TWeakObjectPtr<AActor> Causer;
+
+	/** Damage type passed to TakeDamage */
+	TSubclassOf<UDamageType> DamageTypeClass;
+
+	/** Damage requested */
+	float Damage = 0.0f;
+};
+
+/**
+ * UDamageAggregationSubsystem
+ *
+ * Server-side per-frame damage accumulator.
+ *
+ * Features:
+ * - Hits are queued during the frame, keyed by victim, and resolved in one pass when
+ *   tickable objects tick (after actor and physics ticks, so the same frame)
+ * - Characters take all of a frame's hits at once (ATopDownCharacter::TakeDamageBatch):
+ *   one health change, one replication dirty, one HUD update and one death check
+ * - Contributions stay per instigator in arrival order; the hit that took health to zero gets the kill
+ * - Other victims get their hits through UGameplayStatics::ApplyDamage as before
+ * - TopDown.Damage.Aggregate 0 applies every hit immediately (A/B comparisons)
+ */
+UCLASS()
+class TOPDOWNPROTO_API UDamageAggregationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Queue a hit for resolution this frame (server only)
+	 * @param Victim - Actor that was hit
+	 * @param Damage - Damage to apply
+	 * @param Instigator - Controller credited with the damage
+	 * @param Causer - Actor that caused the damage
+	 * @param DamageTypeClass - Damage type (defaults to UDamageType)
+	 */
+	void QueueDamage(AActor* Victim, float Damage, AController* Instigator, AActor* Causer, TSubclassOf<UDamageType> DamageTypeClass = nullptr);
+
+	/** Apply everything queued so far now */
+	void ResolvePendingDamage();
+
+	/** Write aggregation counters to the log */
+	void LogStats() const;
+
+private:
+	/** A victim's hits this frame */
+	struct FPendingVictim
+	{
+		TWeakObjectPtr<AActor> Victim;
+		TArray<FDamageContribution, TInlineAllocator<4>> Contributions;
+	};
+
+	/** Victims hit this frame, in first-hit order */
+	TArray<FPendingVictim> PendingVictims;
+
+	/** Victim -> index in PendingVictims */
+	TMap<TObjectKey<AActor>, int32> PendingVictimIndices;
+
+	/** Victims being resolved (hits queued while resolving wait for the next pass) */
+	TArray<FPendingVictim> ResolvingVictims;
+
+	/** Aggregation counters */
+	int64 NumHitsQueued = 0;
+	int64 NumVictimsResolved = 0;
+	int64 NumResolvePasses = 0;
+};
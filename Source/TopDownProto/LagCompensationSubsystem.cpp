@@ -0,0 +1,340 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LagCompensationSubsystem.h"
+#include "TopDownStats.h"
+#include "TopDownCharacter.h"
+#include "Projectile.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CVarLagCompensationStats(
+	TEXT("TopDown.LagCompensation.Stats"),
+	TEXT("Log lag compensation rewind cost counters for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+		{
+			LagCompensation->LogStats();
+		}
+	})
+);
+
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	LogStats();
+	Histories.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+// ========================================================================================
+// History Recording
+// ========================================================================================
+
+void ULagCompensationSubsystem::FHistory::Record(float Time, const FVector& Location, const FQuat& Rotation)
+{
+	FSample& NewSample = Samples[Head];
+	NewSample.Time = Time;
+	NewSample.Location = Location;
+	NewSample.Rotation = Rotation;
+
+	Head = (Head + 1) % Samples.Num();
+	Num = FMath::Min(Num + 1, Samples.Num());
+}
+
+bool ULagCompensationSubsystem::FHistory::Sample(float Time, FVector& OutLocation, FQuat& OutRotation) const
+{
+	if (Num == 0)
+	{
+		return false;
+	}
+
+	// Walk from newest to oldest until we find the pair bracketing Time
+	const int32 Capacity = Samples.Num();
+	const FSample* Newer = &Samples[(Head - 1 + Capacity) % Capacity];
+
+	if (Time >= Newer->Time)
+	{
+		OutLocation = Newer->Location;
+		OutRotation = Newer->Rotation;
+		return true;
+	}
+
+	for (int32 Step = 2; Step <= Num; ++Step)
+	{
+		const FSample* Older = &Samples[(Head - Step + Capacity) % Capacity];
+		if (Time >= Older->Time)
+		{
+			const float Span = Newer->Time - Older->Time;
+			const float Alpha = Span > UE_SMALL_NUMBER ? (Time - Older->Time) / Span : 1.0f;
+			OutLocation = FMath::Lerp(Older->Location, Newer->Location, Alpha);
+			OutRotation = FQuat::Slerp(Older->Rotation, Newer->Rotation, Alpha);
+			return true;
+		}
+		Newer = Older;
+	}
+
+	// Older than our history - use the oldest sample we have
+	OutLocation = Newer->Location;
+	OutRotation = Newer->Rotation;
+	return true;
+}
+
+void ULagCompensationSubsystem::RegisterCharacter(ATopDownCharacter* Character)
+{
+	if (!Character || Histories.ContainsByPredicate([Character](const FHistory& History) { return History.Character == Character; }))
+	{
+		return;
+	}
+
+	FHistory& History = Histories.AddDefaulted_GetRef();
+	History.Character = Character;
+	History.Samples.SetNum(FMath::Max(2, HistorySize));
+}
+
+void ULagCompensationSubsystem::UnregisterCharacter(ATopDownCharacter* Character)
+{
+	Histories.RemoveAllSwap([Character](const FHistory& History) { return History.Character == Character; });
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(LagCompensationRecord);
+
+	Super::Tick(DeltaTime);
+
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (FHistory& History : Histories)
+	{
+		if (const ATopDownCharacter* Character = History.Character.Get())
+		{
+			const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+			History.Record(Now, Capsule->GetComponentLocation(), Capsule->GetComponentQuat());
+		}
+	}
+}
+
+// ========================================================================================
+// Rewound Hit Test
+// ========================================================================================
+
+bool ULagCompensationSubsystem::GetShotTiming(const APawn* Shooter, float& OutRewindSeconds, float& OutForwardSeconds) const
+{
+	OutRewindSeconds = 0.0f;
+	OutForwardSeconds = 0.0f;
+
+	// Local and AI shooters see the server's present
+	if (!bEnabled || !Shooter || Shooter->IsLocallyControlled())
+	{
+		return false;
+	}
+
+	const APlayerState* PlayerState = Shooter->GetPlayerState();
+	if (!PlayerState)
+	{
+		return false;
+	}
+
+	ComputeShotTiming(PlayerState->GetPingInMilliseconds() * 0.001f, InterpolationDelay, MaxRewindTime, OutRewindSeconds, OutForwardSeconds);
+	return OutRewindSeconds > 0.0f;
+}
+
+void ULagCompensationSubsystem::ComputeShotTiming(float RoundTripSeconds, float InterpolationDelay, float MaxRewindTime,
+                                                  float& OutRewindSeconds, float& OutForwardSeconds)
+{
+	// Targets on the shooter's screen are one round trip plus interpolation behind the server,
+	// and the shot itself left the muzzle half a round trip ago
+	OutRewindSeconds = FMath::Clamp(RoundTripSeconds + InterpolationDelay, 0.0f, MaxRewindTime);
+	OutForwardSeconds = FMath::Clamp(RoundTripSeconds * 0.5f, 0.0f, MaxRewindTime);
+}
+
+namespace LagCompensation
+{
+	/**
+	 * First contact of a sphere swept from Start to End with a capsule
+	 * (ray against the capsule inflated by the sphere radius)
+	 * @param AxisA - Capsule segment start (bottom sphere center)
+	 * @param AxisB - Capsule segment end (top sphere center)
+	 * @param Radius - Capsule radius plus sphere radius
+	 * @param OutTime - Fraction of Start->End at first contact (0 if Start is already inside)
+	 * @return True on contact within the segment
+	 */
+	bool SweepSphereCapsule(const FVector& Start, const FVector& End, const FVector& AxisA, const FVector& AxisB, float Radius, float& OutTime)
+	{
+		const FVector Dir = End - Start;
+		const FVector Axis = AxisB - AxisA;
+		const FVector FromA = Start - AxisA;
+
+		// Starting inside (point-blank)
+		if (FMath::PointDistToSegmentSquared(Start, AxisA, AxisB) <= FMath::Square(Radius))
+		{
+			OutTime = 0.0f;
+			return true;
+		}
+
+		const double AxisSq = Axis.SizeSquared();
+		const double DirSq = Dir.SizeSquared();
+		if (DirSq <= UE_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const double AxisDotDir = Axis | Dir;
+		const double AxisDotFromA = Axis | FromA;
+
+		// Cylinder body
+		const double A = AxisSq * DirSq - AxisDotDir * AxisDotDir;
+		if (A > UE_SMALL_NUMBER)
+		{
+			const double B = AxisSq * (Dir | FromA) - AxisDotFromA * AxisDotDir;
+			const double C = AxisSq * FromA.SizeSquared() - AxisDotFromA * AxisDotFromA - FMath::Square(Radius) * AxisSq;
+			const double Discriminant = B * B - A * C;
+			if (Discriminant < 0.0)
+			{
+				return false;   // The infinite cylinder is missed, so are the caps
+			}
+
+			const double Time = (-B - FMath::Sqrt(Discriminant)) / A;
+			const double AlongAxis = AxisDotFromA + Time * AxisDotDir;
+			if (AlongAxis > 0.0 && AlongAxis < AxisSq)
+			{
+				OutTime = static_cast<float>(Time);
+				return Time >= 0.0 && Time <= 1.0;
+			}
+		}
+
+		// Hemispherical caps
+		double BestTime = UE_BIG_NUMBER;
+		for (const FVector& CapCenter : { AxisA, AxisB })
+		{
+			const FVector FromCap = Start - CapCenter;
+			const double B = Dir | FromCap;
+			const double C = FromCap.SizeSquared() - FMath::Square(Radius);
+			const double Discriminant = B * B - DirSq * C;
+			if (Discriminant >= 0.0)
+			{
+				BestTime = FMath::Min(BestTime, (-B - FMath::Sqrt(Discriminant)) / DirSq);
+			}
+		}
+
+		OutTime = static_cast<float>(BestTime);
+		return BestTime >= 0.0 && BestTime <= 1.0;
+	}
+}
+
+bool ULagCompensationSubsystem::RewindSweep(const APawn* Shooter, float RewindSeconds, const FVector& Start, const FVector& End,
+                                            const AProjectile* Archetype, FHitResult& OutHit)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(LagCompensationRewind);
+
+	UWorld* World = GetWorld();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const float RewindTime = World->GetTimeSeconds() - FMath::Clamp(RewindSeconds, 0.0f, MaxRewindTime);
+	const float ShotRadius = Archetype->GetCollisionRadius();
+
+	// Present-time sweep for everything but characters (they are tested where the shooter saw them)
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LagCompensatedSweep), false, Shooter);
+	const bool bRewind = bEnabled && RewindSeconds > 0.0f;
+	if (bRewind)
+	{
+		for (const FHistory& History : Histories)
+		{
+			if (const ATopDownCharacter* Character = History.Character.Get())
+			{
+				QueryParams.AddIgnoredActor(Character);
+			}
+		}
+	}
+
+	bool bHit = Archetype->SweepFlight(World, Start, End, QueryParams, OutHit);
+
+	// Rewound capsules: nearer contacts win over the world hit
+	int32 NumCandidates = 0;
+	if (bRewind)
+	{
+		for (const FHistory& History : Histories)
+		{
+			ATopDownCharacter* Character = History.Character.Get();
+			if (!Character || Character == Shooter || Character->IsDead())
+			{
+				continue;
+			}
+
+			FVector RewoundLocation;
+			FQuat RewoundRotation;
+			if (!History.Sample(RewindTime, RewoundLocation, RewoundRotation))
+			{
+				continue;
+			}
+
+			// Cull where the target was, not where it is now (fast movers may have left the path since)
+			UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+			const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+			if (FMath::PointDistToSegment(RewoundLocation, Start, End) > CandidateMargin + CapsuleRadius)
+			{
+				continue;
+			}
+			++NumCandidates;
+
+			const FVector AxisOffset = RewoundRotation.GetUpVector() * FMath::Max(0.0f, Capsule->GetScaledCapsuleHalfHeight() - CapsuleRadius);
+			const FVector AxisA = RewoundLocation - AxisOffset;
+			const FVector AxisB = RewoundLocation + AxisOffset;
+
+			float Time = 0.0f;
+			if (!LagCompensation::SweepSphereCapsule(Start, End, AxisA, AxisB, CapsuleRadius + ShotRadius, Time)
+				|| (bHit && Time >= OutHit.Time))
+			{
+				continue;
+			}
+
+			const FVector Location = FMath::Lerp(Start, End, Time);
+			const FVector Normal = (Location - FMath::ClosestPointOnSegment(Location, AxisA, AxisB)).GetSafeNormal();
+
+			OutHit = FHitResult(Character, Capsule, Location, Normal);
+			OutHit.bBlockingHit = true;
+			OutHit.bStartPenetrating = Time <= 0.0f;
+			OutHit.Time = Time;
+			OutHit.Distance = FVector::Dist(Start, Location);
+			OutHit.TraceStart = Start;
+			OutHit.TraceEnd = End;
+			OutHit.ImpactPoint = Location - Normal * ShotRadius;
+			bHit = true;
+		}
+	}
+
+	// Cost accounting
+	const float CostMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+	Stats.NumRewinds++;
+	Stats.TotalCandidates += NumCandidates;
+	Stats.LastCostMs = CostMs;
+	Stats.MaxCostMs = FMath::Max(Stats.MaxCostMs, CostMs);
+	Stats.AverageCostMs += (CostMs - Stats.AverageCostMs) / Stats.NumRewinds;
+
+	return bHit;
+}
+
+void ULagCompensationSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Lag compensation: %d rewinds, %.2f candidates/shot, cost last %.3f ms, avg %.3f ms, max %.3f ms"),
+	       Stats.NumRewinds,
+	       Stats.NumRewinds > 0 ? static_cast<float>(Stats.TotalCandidates) / Stats.NumRewinds : 0.0f,
+	       Stats.LastCostMs, Stats.AverageCostMs, Stats.MaxCostMs);
+}
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class ATopDownCharacter;
+class AProjectile;
+
+/**
+ * FLagCompensationStats
+ *
+ * Cost counters for rewound hit tests.
+ */
+USTRUCT(BlueprintType)
+struct FLagCompensationStats
+{
+	GENERATED_BODY()
+
+	/** Number of rewound hit tests performed */
+	UPROPERTY(BlueprintReadOnly, Category = "Lag Compensation")
+	int32 NumRewinds = 0;
+
+	/** Total number of rewound capsules tested across all tests */
+	UPROPERTY(BlueprintReadOnly, Category = "Lag Compensation")
+	int32 TotalCandidates = 0;
+
+	/** Cost of the most recent test (rewound capsule tests + world sweep) in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Lag Compensation")
+	float LastCostMs = 0.0f;
+
+	/** Average cost per test in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Lag Compensation")
+	float AverageCostMs = 0.0f;
+
+	/** Most expensive test in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Lag Compensation")
+	float MaxCostMs = 0.0f;
+};
+
+/**
+ * ULagCompensationSubsystem
+ *
+ * Server-side lag compensation for shots.
+ *
+ * Records every registered character's capsule transform into a fixed-size
+ * ring buffer each server tick. At fire time, the shot is tested against the
+ * capsules of candidate targets sampled at the shooter's estimated view time
+ * (analytically; nothing in the world is moved) and swept once against the
+ * present world for everything else.
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Start recording transform history for a character (server only) */
+	void RegisterCharacter(ATopDownCharacter* Character);
+
+	/** Stop recording transform history for a character */
+	void UnregisterCharacter(ATopDownCharacter* Character);
+
+	/**
+	 * Estimate how a remote shooter's view lagged behind the server when firing
+	 * @param Shooter - Pawn that fired
+	 * @param OutRewindSeconds - How far back targets were on the shooter's screen (round trip + interpolation)
+	 * @param OutForwardSeconds - How long the shot has been in flight on the shooter's screen (one way)
+	 * @return False for local/AI shooters or when disabled (both outputs are 0)
+	 */
+	bool GetShotTiming(const APawn* Shooter, float& OutRewindSeconds, float& OutForwardSeconds) const;
+
+	/**
+	 * Shot timing for a round trip time (GetShotTiming without the shooter lookup)
+	 * @param RoundTripSeconds - Shooter's ping in seconds
+	 * @param InterpolationDelay - How far behind the latest server state clients render simulated proxies
+	 * @param MaxRewindTime - Upper bound on both outputs
+	 * @param OutRewindSeconds - Round trip + interpolation
+	 * @param OutForwardSeconds - One way (half the round trip)
+	 */
+	static void ComputeShotTiming(float RoundTripSeconds, float InterpolationDelay, float MaxRewindTime, float& OutRewindSeconds, float& OutForwardSeconds);
+
+	/**
+	 * Sweep a shot against targets rewound to a past time
+	 * Characters are hit at their sampled capsules; other geometry is swept with the projectile's collision
+	 * @param Shooter - Pawn that fired (never rewound or hit)
+	 * @param RewindSeconds - How far back to rewind targets
+	 * @param Start - Sweep start
+	 * @param End - Sweep end
+	 * @param Archetype - Projectile class default object (shot radius, channel and responses)
+	 * @param OutHit - First blocking hit
+	 * @return True if something was hit
+	 */
+	bool RewindSweep(const APawn* Shooter, float RewindSeconds, const FVector& Start, const FVector& End, const AProjectile* Archetype,
+	                 FHitResult& OutHit);
+
+	/** Get rewind cost counters */
+	UFUNCTION(BlueprintPure, Category = "Lag Compensation")
+	FLagCompensationStats GetStats() const { return Stats; }
+
+	/** Write rewind cost counters to the log */
+	void LogStats() const;
+
+protected:
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Master switch */
+	UPROPERTY(Config)
+	bool bEnabled = true;
+
+	/** Samples kept per character (bounds memory; must cover MaxRewindTime at the server tick rate) */
+	UPROPERTY(Config)
+	int32 HistorySize = 64;
+
+	/** Maximum time in seconds a shot may be rewound */
+	UPROPERTY(Config)
+	float MaxRewindTime = 0.25f;
+
+	/** Extra delay (seconds) clients render simulated proxies behind the latest server state */
+	UPROPERTY(Config)
+	float InterpolationDelay = 0.05f;
+
+	/** Characters further than this from the shot (at their rewound position) are not rewound */
+	UPROPERTY(Config)
+	float CandidateMargin = 300.0f;
+
+private:
+	/** Single recorded capsule transform */
+	struct FSample
+	{
+		float Time = 0.0f;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+	};
+
+	/** Fixed-size ring buffer of samples for one character */
+	struct FHistory
+	{
+		TWeakObjectPtr<ATopDownCharacter> Character;
+		TArray<FSample> Samples;
+		int32 Head = 0;
+		int32 Num = 0;
+
+		void Record(float Time, const FVector& Location, const FQuat& Rotation);
+		bool Sample(float Time, FVector& OutLocation, FQuat& OutRotation) const;
+	};
+
+	/** Per-character transform histories */
+	TArray<FHistory> Histories;
+
+	/** Rewind cost counters */
+	FLagCompensationStats Stats;
+};
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LoadTestSubsystem.h"
+#include "TopDownPerfReport.h"
+#include "TopDownCharacter.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ManagedProjectileSubsystem.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+static FAutoConsoleCommandWithWorld CVarLoadTestReport(
+	TEXT("TopDown.LoadTest.Report"),
+	TEXT("Write the load test summary (frame time percentiles, bandwidth, projectile and actor counts) now"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ULoadTestSubsystem* LoadTest = World ? World->GetSubsystem<ULoadTestSubsystem>() : nullptr)
+		{
+			LoadTest->WriteReport();
+		}
+	})
+);
+
+bool ULoadTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId ULoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULoadTestSubsystem, STATGROUP_Tickables);
+}
+
+void ULoadTestSubsystem::StartLoadTest(int32 InNumBots, float InDuration)
+{
+	NumBots = InNumBots;
+
+	MeasureDuration = Duration;
+	FParse::Value(FCommandLine::Get(), TEXT("loadtestduration="), MeasureDuration);
+	if (InDuration > 0.0f)
+	{
+		MeasureDuration = InDuration;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	MeasureStartTime = StartTime + WarmupTime;
+	NextSecondSampleTime = MeasureStartTime + 1.0;
+
+	// Reserve for the whole run up front (a 120 Hz server for the default minute)
+	GameThreadTimesMs.Reset();
+	GameThreadTimesMs.Reserve(FMath::CeilToInt(MeasureDuration * 120.0f));
+	FrameTimesMs.Reset();
+	FrameTimesMs.Reserve(FMath::CeilToInt(MeasureDuration * 120.0f));
+	SecondSamples.Reset();
+
+	bRunning = true;
+	bReported = false;
+
+	UE_LOG(LogTemp, Log, TEXT("Load test started: %d bots, %.0f s warmup, %.0f s measured"), NumBots, WarmupTime, MeasureDuration);
+}
+
+void ULoadTestSubsystem::Tick(float DeltaTime)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now < MeasureStartTime)
+	{
+		return;
+	}
+
+	// Game thread work (excludes the idle wait for the server tick rate) and the full frame
+	GameThreadTimesMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+	FrameTimesMs.Add(static_cast<float>(FApp::GetDeltaTime() * 1000.0));
+
+	if (Now >= NextSecondSampleTime)
+	{
+		NextSecondSampleTime += 1.0;
+		SampleSecond();
+	}
+
+	if (!bReported && Now - MeasureStartTime >= MeasureDuration)
+	{
+		bReported = true;
+		bRunning = false;
+		WriteReport();
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("loadtestquit")))
+		{
+			FPlatformMisc::RequestExit(false, TEXT("ULoadTestSubsystem"));
+		}
+	}
+}
+
+void ULoadTestSubsystem::SampleSecond()
+{
+	UWorld* World = GetWorld();
+	FSecondSample& Sample = SecondSamples.AddZeroed_GetRef();
+
+	if (const UNetDriver* NetDriver = World->GetNetDriver())
+	{
+		Sample.OutKBytesPerSecond = NetDriver->OutBytesPerSecond / 1024.0f;
+		Sample.InKBytesPerSecond = NetDriver->InBytesPerSecond / 1024.0f;
+	}
+
+	if (const UProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Sample.NumProjectiles += ProjectilePool->GetTotalStats().NumActive;
+	}
+	if (const UManagedProjectileSubsystem* ManagedProjectiles = World->GetSubsystem<UManagedProjectileSubsystem>())
+	{
+		Sample.NumProjectiles += ManagedProjectiles->GetNumProjectiles();
+	}
+
+	for (TActorIterator<ATopDownCharacter> It(World); It; ++It)
+	{
+		if (!It->IsPooled())
+		{
+			++Sample.NumCharacters;
+		}
+	}
+
+	Sample.NumActors = World->GetActorCount();
+}
+
+// ========================================================================================
+// Report
+// ========================================================================================
+
+float ULoadTestSubsystem::GetGameThreadTimePercentile(float Fraction) const
+{
+	TArray<float> Sorted = GameThreadTimesMs;
+	Sorted.Sort();
+	return TopDownPerf::Percentile(Sorted, Fraction);
+}
+
+FString ULoadTestSubsystem::WriteReport() const
+{
+	using namespace TopDownPerf;
+
+	TArray<float> OutKBytes, InKBytes, Projectiles, Characters, Actors;
+	for (const FSecondSample& Sample : SecondSamples)
+	{
+		OutKBytes.Add(Sample.OutKBytesPerSecond);
+		InKBytes.Add(Sample.InKBytesPerSecond);
+		Projectiles.Add(static_cast<float>(Sample.NumProjectiles));
+		Characters.Add(static_cast<float>(Sample.NumCharacters));
+		Actors.Add(static_cast<float>(Sample.NumActors));
+	}
+
+	const UWorld* World = GetWorld();
+	const UNetDriver* NetDriver = World->GetNetDriver();
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("map"), World->GetMapName());
+	Report->SetNumberField(TEXT("bots"), NumBots);
+	Report->SetNumberField(TEXT("connections"), NetDriver ? NetDriver->ClientConnections.Num() : 0);
+	Report->SetNumberField(TEXT("measured_seconds"), FMath::Max(0.0, FPlatformTime::Seconds() - MeasureStartTime));
+	Report->SetObjectField(TEXT("game_thread_ms"), MakeDistribution(GameThreadTimesMs));
+	Report->SetObjectField(TEXT("frame_ms"), MakeDistribution(FrameTimesMs));
+	Report->SetObjectField(TEXT("out_kbytes_per_sec"), MakeDistribution(OutKBytes));
+	Report->SetObjectField(TEXT("in_kbytes_per_sec"), MakeDistribution(InKBytes));
+	Report->SetObjectField(TEXT("projectiles"), MakeDistribution(Projectiles));
+	Report->SetObjectField(TEXT("characters"), MakeDistribution(Characters));
+	Report->SetObjectField(TEXT("actors"), MakeDistribution(Actors));
+
+	const FString Path = SaveReport(Report, TEXT("LoadTest"), FString::Printf(TEXT("LoadTest_%dbots"), NumBots));
+	if (Path.IsEmpty())
+	{
+		return FString();
+	}
+
+	TArray<float> SortedGameThread = GameThreadTimesMs;
+	SortedGameThread.Sort();
+	UE_LOG(LogTemp, Log, TEXT("Load test (%d bots): game thread p50 %.2f ms, p99 %.2f ms over %d frames -> %s"),
+	       NumBots, Percentile(SortedGameThread, 0.50f), Percentile(SortedGameThread, 0.99f), SortedGameThread.Num(), *Path);
+	return Path;
+}
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LoadTestSubsystem.generated.h"
+
+/**
+ * ULoadTestSubsystem
+ *
+ * Server capacity measurement for bot load tests (server only).
+ * Started by ATopDownGameMode when it spawns bots for -bots=N.
+ *
+ * Features:
+ * - Per-frame game thread time and frame time, reported as p50/p90/p95/p99/max
+ * - Once-per-second samples of net driver bandwidth, projectiles in flight, characters and actors
+ * - JSON summary written to Saved/LoadTest/ after -loadtestduration=S seconds (default Duration),
+ *   then the server exits if -loadtestquit is on the command line
+ * - TopDown.LoadTest.Report writes the summary on demand
+ *
+ * Built into the dedicated server target (TopDownProtoServer), which runs without a renderer:
+ *   TopDownProtoServer Arena -log -bots=64 -loadtestduration=120 -loadtestquit
+ * (from an editor build: UnrealEditor TopDownProto Arena -server -nullrhi -bots=64 ...)
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API ULoadTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Start measuring (samples taken during the warmup are discarded)
+	 * @param InNumBots - Bots in the match, recorded in the summary
+	 * @param InDuration - Measured seconds (0 = -loadtestduration= or the configured Duration)
+	 */
+	void StartLoadTest(int32 InNumBots, float InDuration = 0.0f);
+
+	/** Is a load test being measured? */
+	bool IsRunning() const { return bRunning; }
+
+	/** Percentile of the measured game thread time in milliseconds (0 before any frame was measured) */
+	float GetGameThreadTimePercentile(float Fraction) const;
+
+	/** Number of frames measured so far */
+	int32 GetNumMeasuredFrames() const { return GameThreadTimesMs.Num(); }
+
+	/**
+	 * Write the JSON summary and log the headline numbers
+	 * @return Path of the written file (empty on failure)
+	 */
+	FString WriteReport() const;
+
+protected:
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Seconds ignored after the start while bots spawn and the pools warm up */
+	UPROPERTY(Config)
+	float WarmupTime = 5.0f;
+
+	/** Measured seconds before the report is written (overridden by -loadtestduration=) */
+	UPROPERTY(Config)
+	float Duration = 60.0f;
+
+private:
+	/** Once-per-second sample of the server's load */
+	struct FSecondSample
+	{
+		float OutKBytesPerSecond;
+		float InKBytesPerSecond;
+		int32 NumProjectiles;
+		int32 NumCharacters;
+		int32 NumActors;
+	};
+
+	/** Take a once-per-second sample */
+	void SampleSecond();
+
+	/** Measurement window */
+	bool bRunning = false;
+	bool bReported = false;
+	int32 NumBots = 0;
+	double StartTime = 0.0;
+	double MeasureStartTime = 0.0;
+	double NextSecondSampleTime = 0.0;
+	float MeasureDuration = 0.0f;
+
+	/** Per-frame samples in milliseconds */
+	TArray<float> GameThreadTimesMs;
+	TArray<float> FrameTimesMs;
+
+	/** Per-second samples */
+	TArray<FSecondSample> SecondSamples;
+};
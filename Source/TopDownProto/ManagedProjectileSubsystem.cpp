@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ManagedProjectileSubsystem.h"
+#include "TopDownStats.h"
+#include "Projectile.h"
+#include "ProjectilePoolSubsystem.h"
+#include "CosmeticEventSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+namespace ManagedProjectiles
+{
+	/** Minimum real time between projectile limit warnings */
+	constexpr double EvictionWarningInterval = 10.0;
+}
+
+bool UManagedProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UManagedProjectileSubsystem::Deinitialize()
+{
+	UE_LOG(LogTemp, Log, TEXT("Managed projectiles: %d in flight at shutdown, high-water %d, %d evicted"), Positions.Num(), HighWaterMark, NumEvicted);
+
+	Super::Deinitialize();
+}
+
+TStatId UManagedProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UManagedProjectileSubsystem, STATGROUP_Tickables);
+}
+
+bool UManagedProjectileSubsystem::SpawnProjectile(TSubclassOf<AProjectile> ProjectileClass, const FVector& Location,
+                                                  const FVector& Direction, APawn* InInstigator, bool bSendImpactEvents)
+{
+	const AProjectile* Archetype = ProjectileClass ? ProjectileClass->GetDefaultObject<AProjectile>() : nullptr;
+	if (!Archetype || !GetWorld())
+	{
+		return false;
+	}
+
+	// The shooter already paid for this shot; drop the one that would have expired first instead
+	while (Positions.Num() >= FMath::Max(MaxProjectiles, 1))
+	{
+		EvictProjectile();
+	}
+
+	Positions.Add(Location);
+	Velocities.Add(Direction * Archetype->InitialSpeed);
+	RemainingLifetimes.Add(Archetype->Lifetime);
+	Damages.Add(Archetype->Damage);
+	GravityZ.Add(Archetype->bAffectedByGravity ? GetWorld()->GetGravityZ() : 0.0f);
+	Archetypes.Add(Archetype);
+	Instigators.Add(InInstigator);
+	ImpactEventClasses.Add(bSendImpactEvents ? ProjectileClass.Get() : nullptr);
+
+	HighWaterMark = FMath::Max(HighWaterMark, Positions.Num());
+	return true;
+}
+
+void UManagedProjectileSubsystem::Tick(float DeltaTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(ManagedProjectiles);
+
+	Super::Tick(DeltaTime);
+
+	const int32 NumProjectiles = Positions.Num();
+	UWorld* World = GetWorld();
+
+	const UProjectilePoolSubsystem* ProjectilePool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+	TOPDOWN_SET_COUNTER(ProjectilesAlive, NumProjectiles + (ProjectilePool ? ProjectilePool->GetTotalStats().NumActive : 0));
+
+	if (NumProjectiles == 0 || !World)
+	{
+		return;
+	}
+
+	// 1. Integrate - straight-line movement with optional gravity
+	EndPositions.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		Velocities[Index].Z += GravityZ[Index] * DeltaTime;
+		EndPositions[Index] = Positions[Index] + Velocities[Index] * DeltaTime;
+		RemainingLifetimes[Index] -= DeltaTime;
+	}
+
+	// 2. Sweep - one query per projectile against what its archetype's collision blocks
+	Hits.SetNum(NumProjectiles, EAllowShrinking::No);
+	HitMask.Init(false, NumProjectiles);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ManagedProjectileSweep), false);
+
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		QueryParams.ClearIgnoredSourceObjects();
+		if (APawn* InstigatorPawn = Instigators[Index].Get())
+		{
+			QueryParams.AddIgnoredActor(InstigatorPawn);
+		}
+
+		HitMask[Index] = Archetypes[Index]->SweepFlight(World, Positions[Index], EndPositions[Index], QueryParams, Hits[Index]);
+	}
+
+	// 3. Resolve - back to front so swap-removal doesn't skip entries
+	UCosmeticEventSubsystem* CosmeticEvents = World->GetSubsystem<UCosmeticEventSubsystem>();
+	for (int32 Index = NumProjectiles - 1; Index >= 0; --Index)
+	{
+		if (HitMask[Index])
+		{
+			const FHitResult& Hit = Hits[Index];
+			APawn* InstigatorPawn = Instigators[Index].Get();
+
+			if (CosmeticEvents && ImpactEventClasses[Index])
+			{
+				CosmeticEvents->QueueEvent(ECosmeticEventType::Impact, ImpactEventClasses[Index], Hit.ImpactPoint, Hit.ImpactNormal);
+			}
+
+			if (AActor* HitActor = Hit.GetActor())
+			{
+				AProjectile::ApplyProjectileDamage(
+					HitActor,
+					Damages[Index],
+					InstigatorPawn ? InstigatorPawn->GetController() : nullptr,
+					InstigatorPawn
+				);
+			}
+
+			RemoveProjectileAtSwap(Index);
+		}
+		else if (RemainingLifetimes[Index] <= 0.0f)
+		{
+			RemoveProjectileAtSwap(Index);
+		}
+		else
+		{
+			Positions[Index] = EndPositions[Index];
+		}
+	}
+}
+
+void UManagedProjectileSubsystem::RemoveProjectileAtSwap(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLifetimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Archetypes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ImpactEventClasses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UManagedProjectileSubsystem::EvictProjectile()
+{
+	int32 EvictIndex = 0;
+	for (int32 Index = 1; Index < RemainingLifetimes.Num(); ++Index)
+	{
+		if (RemainingLifetimes[Index] < RemainingLifetimes[EvictIndex])
+		{
+			EvictIndex = Index;
+		}
+	}
+	RemoveProjectileAtSwap(EvictIndex);
+
+	++NumEvicted;
+	++NumEvictedSinceWarning;
+	TOPDOWN_INC_COUNTER(ManagedProjectilesEvicted, 1);
+
+	// Under sustained load this happens every shot; say so once in a while, not every frame
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastEvictionWarningTime >= ManagedProjectiles::EvictionWarningInterval)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Managed projectile limit (%d) reached - %d projectiles closest to expiring evicted since the last warning"),
+		       MaxProjectiles, NumEvictedSinceWarning);
+		LastEvictionWarningTime = Now;
+		NumEvictedSinceWarning = 0;
+	}
+}
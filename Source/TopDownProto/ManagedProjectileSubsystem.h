@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ManagedProjectileSubsystem.generated.h"
+
+class AProjectile;
+
+/**
+ * UManagedProjectileSubsystem
+ *
+ * Server-side batched projectile simulation without an actor per bullet.
+ *
+ * Projectiles are stored as a structure of arrays and advanced together once
+ * per frame:
+ * 1. Integrate velocity/position and age every projectile
+ * 2. Sweep every projectile along its movement for this frame, with its archetype's collision
+ * 3. Resolve hits through the same damage path AProjectile::OnHit uses
+ *
+ * Used by UWeaponComponent when ProjectileSimulationMode is Managed.
+ * At MaxProjectiles the projectile closest to expiring is evicted, so a fired (and paid for)
+ * shot is never dropped.
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API UManagedProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Add a projectile to the simulation (server only)
+	 * Speed, lifetime, damage, radius and gravity are read from the archetype's defaults
+	 * @param ProjectileClass - Projectile archetype to simulate
+	 * @param Location - Spawn location (muzzle)
+	 * @param Direction - Normalized fire direction
+	 * @param InInstigator - Pawn responsible for damage dealt by the projectile
+	 * @param bSendImpactEvents - Queue a cosmetic impact event on hit (off when clients simulate the projectile themselves)
+	 * @return True if the projectile was added (false only without a projectile class or world)
+	 */
+	bool SpawnProjectile(TSubclassOf<AProjectile> ProjectileClass, const FVector& Location, const FVector& Direction, APawn* InInstigator,
+	                     bool bSendImpactEvents = true);
+
+	/** Get number of projectiles currently in flight */
+	UFUNCTION(BlueprintPure, Category = "Managed Projectiles")
+	int32 GetNumProjectiles() const { return Positions.Num(); }
+
+	/** Get highest number of projectiles that were in flight at the same time */
+	UFUNCTION(BlueprintPure, Category = "Managed Projectiles")
+	int32 GetHighWaterMark() const { return HighWaterMark; }
+
+	/** Get number of projectiles evicted to make room for new shots */
+	UFUNCTION(BlueprintPure, Category = "Managed Projectiles")
+	int32 GetNumEvicted() const { return NumEvicted; }
+
+protected:
+	/** Upper bound on projectiles in flight (the one closest to expiring is evicted for a new shot) */
+	UPROPERTY(Config)
+	int32 MaxProjectiles = 8192;
+
+private:
+	/** Remove projectile at Index by swapping the last one into its slot */
+	void RemoveProjectileAtSwap(int32 Index);
+
+	/** Make room for one more projectile by removing the one closest to expiring */
+	void EvictProjectile();
+
+	// ========================================================================================
+	// Projectile Store (structure of arrays, all arrays share the same index)
+	// ========================================================================================
+
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> RemainingLifetimes;
+	TArray<float> Damages;
+	TArray<float> GravityZ;
+	TArray<const AProjectile*> Archetypes;     // Class default objects: collision shape, channel and responses
+	TArray<TWeakObjectPtr<APawn>> Instigators;
+	TArray<UClass*> ImpactEventClasses;    // null = no impact event
+
+	/** Per-frame scratch: end of this frame's movement and sweep result */
+	TArray<FVector> EndPositions;
+	TArray<FHitResult> Hits;
+	TBitArray<> HitMask;
+
+	/** Highest number of projectiles in flight */
+	int32 HighWaterMark = 0;
+
+	/** Evictions in total and since the last limit warning (logged at most every few seconds) */
+	int32 NumEvicted = 0;
+	int32 NumEvictedSinceWarning = 0;
+	double LastEvictionWarningTime = -UE_BIG_NUMBER;
+};
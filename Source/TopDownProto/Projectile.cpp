@@ -1,12 +1,21 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Projectile.h"
+#include "TopDownStats.h"
+#include "TopDownCombatLog.h"
+#include "CombatJournal.h"
+#include "ProjectilePoolSubsystem.h"
+#include "SpatialGridSubsystem.h"
+#include "CosmeticEventSubsystem.h"
+#include "DamageAggregationSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "GameFramework/DamageType.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 AProjectile::AProjectile()
 {
@@ -53,8 +62,20 @@ AProjectile::AProjectile()
 	HitEffect = nullptr;
 	HitSound = nullptr;
 
-	// Set initial lifespan
-	InitialLifeSpan = Lifetime;
+	// Lifetime is driven by LifetimeTimerHandle so pooled projectiles can be recycled
+	InitialLifeSpan = 0.0f;
+
+	// Pooling state
+	OwningPool = nullptr;
+	PoolActivationId = 0;
+	bCosmeticOnly = false;
+}
+
+void AProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AProjectile, PoolActivationId);
 }
 
 void AProjectile::BeginPlay()
@@ -75,10 +96,24 @@ void AProjectile::BeginPlay()
 		ProjectileMovement->ProjectileGravityScale = bAffectedByGravity ? 1.0f : 0.0f;
 	}
 
-	// Set lifespan
-	SetLifeSpan(Lifetime);
+	// Pooled projectiles start their lifetime when activated
+	if (!OwningPool)
+	{
+		StartLifetimeTimer();
+	}
+
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Projectile spawned: %s"), *GetName());
+}
+
+void AProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Pooled projectiles torn down while in flight
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+	{
+		SpatialGrid->UnregisterActor(this);
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Projectile spawned: %s"), *GetName());
+	Super::EndPlay(EndPlayReason);
 }
 
 void AProjectile::FireInDirection(const FVector& Direction)
@@ -86,14 +121,27 @@ void AProjectile::FireInDirection(const FVector& Direction)
 	if (ProjectileMovement)
 	{
 		ProjectileMovement->Velocity = Direction * InitialSpeed;
-		UE_LOG(LogTemp, Log, TEXT("Projectile fired in direction: %s at speed: %.2f"), 
-		       *Direction.ToString(), InitialSpeed);
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Projectile fired in direction: %s at speed: %.2f"),
+		                   *Direction.ToString(), InitialSpeed);
 	}
 }
 
 void AProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
                         FVector NormalImpulse, const FHitResult& Hit)
 {
+	TOPDOWN_SCOPE_CYCLE_COUNTER(ProjectileOnHit);
+
+	// Cosmetic copies only show the impact
+	if (bCosmeticOnly)
+	{
+		if (OtherActor != GetInstigator())
+		{
+			PlayHitEffects(GetWorld(), Hit.ImpactPoint, Hit.ImpactNormal);
+			OnProjectileDestroy();
+		}
+		return;
+	}
+
 	// Only execute on server
 	if (!HasAuthority())
 	{
@@ -103,48 +151,221 @@ void AProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimi
 	// Don't hit ourselves or our instigator
 	if (OtherActor && OtherActor != this && OtherActor != GetInstigator())
 	{
-		UE_LOG(LogTemp, Log, TEXT("Projectile hit: %s at location %s"), 
-		       *OtherActor->GetName(), *Hit.ImpactPoint.ToString());
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Projectile hit: %s at location %s"),
+		                   *OtherActor->GetName(), *Hit.ImpactPoint.ToString());
+		FCombatJournal::Get().Record(ECombatJournalEvent::Hit, GetInstigator(), OtherActor, Hit.ImpactPoint, Damage);
 
-		// Play hit effects on all clients
-		MulticastPlayHitEffects(Hit.ImpactPoint, Hit.ImpactNormal);
-
-		// Apply damage to hit actor
-		if (Damage > 0.0f)
+		// Play hit effects on nearby clients
+		if (UCosmeticEventSubsystem* CosmeticEvents = GetWorld()->GetSubsystem<UCosmeticEventSubsystem>())
 		{
-			UGameplayStatics::ApplyDamage(
-				OtherActor,
-				Damage,
-				GetInstigatorController(),
-				this,
-				UDamageType::StaticClass()
-			);
-
-			UE_LOG(LogTemp, Log, TEXT("Applied %.2f damage to %s"), Damage, *OtherActor->GetName());
+			CosmeticEvents->QueueEvent(ECosmeticEventType::Impact, GetClass(), Hit.ImpactPoint, Hit.ImpactNormal);
 		}
 
+		// Apply damage to hit actor (caused by the shooter, like shots that never get a projectile actor)
+		ApplyProjectileDamage(OtherActor, Damage, GetInstigatorController(), GetInstigator());
+
 		// Handle destruction
 		OnProjectileDestroy();
 	}
 }
 
+void AProjectile::ApplyProjectileDamage(AActor* HitActor, float DamageAmount, AController* InstigatorController, AActor* DamageCauser)
+{
+	if (!HitActor || DamageAmount <= 0.0f)
+	{
+		return;
+	}
+
+	TOPDOWN_INC_COUNTER(Hits, 1);
+
+	// Hits on the same victim this frame are resolved together
+	if (UDamageAggregationSubsystem* DamageAggregation = HitActor->GetWorld()->GetSubsystem<UDamageAggregationSubsystem>())
+	{
+		DamageAggregation->QueueDamage(HitActor, DamageAmount, InstigatorController, DamageCauser, UDamageType::StaticClass());
+	}
+	else
+	{
+		UGameplayStatics::ApplyDamage(
+			HitActor,
+			DamageAmount,
+			InstigatorController,
+			DamageCauser,
+			UDamageType::StaticClass()
+		);
+	}
+
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Queued %.2f damage to %s"), DamageAmount, *HitActor->GetName());
+}
+
 void AProjectile::OnProjectileDestroy()
 {
 	// Server handles destruction
 	if (HasAuthority())
 	{
-		UE_LOG(LogTemp, Log, TEXT("Destroying projectile: %s"), *GetName());
+		GetWorldTimerManager().ClearTimer(LifetimeTimerHandle);
+
+		// Pooled projectiles go back to their pool instead of being destroyed
+		if (OwningPool)
+		{
+			OwningPool->ReleaseProjectile(this);
+			return;
+		}
+
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Destroying projectile: %s"), *GetName());
 		Destroy();
 	}
 }
 
-void AProjectile::MulticastPlayHitEffects_Implementation(FVector_NetQuantize HitLocation, FVector_NetQuantize HitNormal)
+void AProjectile::OnLifetimeExpired()
+{
+	OnProjectileDestroy();
+}
+
+void AProjectile::StartLifetimeTimer()
+{
+	GetWorldTimerManager().SetTimer(
+		LifetimeTimerHandle,
+		this,
+		&AProjectile::OnLifetimeExpired,
+		Lifetime,
+		false
+	);
+}
+
+// ========================================================================================
+// Pooling
+// ========================================================================================
+
+void AProjectile::ActivateFromPool(const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator)
+{
+	// Reopen the channels closed while pooled before anything replicated changes
+	if (GetIsReplicated())
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+
+	SetOwner(NewOwner);
+	SetInstigator(NewInstigator);
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Skip 0 on wrap-around, it means "in pool"
+	PoolActivationId = (PoolActivationId == MAX_uint8) ? 1 : PoolActivationId + 1;
+	ApplyPoolActivationState();
+
+	// Replicated projectiles are queryable on the server while in flight
+	if (!bCosmeticOnly)
+	{
+		if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+		{
+			SpatialGrid->RegisterActor(this, ESpatialGridCategory::Projectile);
+		}
+	}
+
+	StartLifetimeTimer();
+	ForceNetUpdate();
+}
+
+void AProjectile::DeactivateToPool()
+{
+	GetWorldTimerManager().ClearTimer(LifetimeTimerHandle);
+
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->UnregisterActor(this);
+	}
+
+	SetOwner(nullptr);
+	SetInstigator(nullptr);
+
+	PoolActivationId = 0;
+	ApplyPoolActivationState();
+
+	// The replication graph keeps gathering grid actors regardless of visibility, so stop replicating a
+	// pooled projectile explicitly; the final (inactive) state is flushed before the channel goes dormant
+	if (GetIsReplicated())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void AProjectile::ApplyPoolActivationState()
+{
+	const bool bActive = PoolActivationId != 0;
+
+	SetActorHiddenInGame(!bActive);
+
+	if (CollisionComponent)
+	{
+		CollisionComponent->SetCollisionEnabled(bActive ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+	}
+
+	if (ProjectileMovement)
+	{
+		if (bActive)
+		{
+			// ProjectileMovement clears its updated component when it stops on a hit
+			ProjectileMovement->SetUpdatedComponent(CollisionComponent);
+			ProjectileMovement->Activate(true);
+
+			// Clients pick the launch velocity up from replicated movement (server sets it in FireInDirection)
+			if (!HasAuthority())
+			{
+				ProjectileMovement->Velocity = GetReplicatedMovement().LinearVelocity;
+			}
+		}
+		else
+		{
+			ProjectileMovement->StopMovementImmediately();
+			ProjectileMovement->Deactivate();
+		}
+	}
+}
+
+void AProjectile::OnRep_PoolActivationId()
+{
+	ApplyPoolActivationState();
+}
+
+void AProjectile::SetCosmeticOnly(bool bInCosmeticOnly)
 {
+	bCosmeticOnly = bInCosmeticOnly;
+	SetReplicates(!bInCosmeticOnly);
+}
+
+bool AProjectile::SweepFlight(const UWorld* World, const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams,
+                              FHitResult& OutHit) const
+{
+	if (!World || !CollisionComponent)
+	{
+		return false;
+	}
+
+	// Same channel and responses the projectile movement component sweeps the actor with
+	return World->SweepSingleByChannel(
+		OutHit,
+		Start,
+		End,
+		FQuat::Identity,
+		CollisionComponent->GetCollisionObjectType(),
+		FCollisionShape::MakeSphere(GetCollisionRadius()),
+		QueryParams,
+		FCollisionResponseParams(CollisionComponent->GetCollisionResponseToChannels())
+	);
+}
+
+float AProjectile::GetCollisionRadius() const
+{
+	return CollisionComponent ? CollisionComponent->GetUnscaledSphereRadius() : 5.0f;
+}
+
+void AProjectile::PlayHitEffects(UWorld* World, const FVector& HitLocation, const FVector& HitNormal) const
+{
+#if !UE_SERVER
 	// Play hit particle effect
 	if (HitEffect)
 	{
 		UGameplayStatics::SpawnEmitterAtLocation(
-			GetWorld(),
+			World,
 			HitEffect,
 			HitLocation,
 			HitNormal.Rotation(),
@@ -157,12 +378,12 @@ void AProjectile::MulticastPlayHitEffects_Implementation(FVector_NetQuantize Hit
 	if (HitSound)
 	{
 		UGameplayStatics::PlaySoundAtLocation(
-			this,
+			World,
 			HitSound,
 			HitLocation
 		);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Playing hit effects at %s"), *HitLocation.ToString());
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Playing hit effects at %s"), *HitLocation.ToString());
+#endif
 }
-
@@ -9,6 +9,7 @@
 class USphereComponent;
 class UProjectileMovementComponent;
 class UStaticMeshComponent;
+class UProjectilePoolSubsystem;
 
 /**
  * AProjectile
@@ -20,8 +21,9 @@ class UStaticMeshComponent;
  * - Sphere collision component
  * - Projectile movement (straight line with gravity option)
  * - Network replication
- * - Automatic destruction after lifetime expires
+ * - Automatic destruction (or return to pool) after lifetime expires
  * - Hit event handling
+ * - Reusable through UProjectilePoolSubsystem
  */
 UCLASS()
 class TOPDOWNPROTO_API AProjectile : public AActor
@@ -37,6 +39,11 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
+	//~ Begin AActor Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~ End AActor Interface
+
 	// ========================================================================================
 	// Components
 	// ========================================================================================
@@ -65,7 +72,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile|Movement", meta = (ClampMin = "100.0"))
 	float MaxSpeed;
 
-	/** Time in seconds before projectile is automatically destroyed */
+	/** Time in seconds before projectile is automatically destroyed (or returned to its pool) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile|Lifetime", meta = (ClampMin = "0.1"))
 	float Lifetime;
 
@@ -89,6 +96,77 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Projectile")
 	void FireInDirection(const FVector& Direction);
 
+	/**
+	 * Damage path shared by projectile actors and managed projectiles (server only)
+	 * Hits are queued on UDamageAggregationSubsystem and applied together at the end of the frame
+	 * @param HitActor - Actor that was hit
+	 * @param DamageAmount - Damage to apply
+	 * @param InstigatorController - Controller credited with the damage
+	 * @param DamageCauser - Pawn that fired; every path passes the shooter, since managed and lag-compensated
+	 *                      shots have no projectile actor and pooled ones are recycled before aggregated damage resolves
+	 */
+	static void ApplyProjectileDamage(AActor* HitActor, float DamageAmount, AController* InstigatorController, AActor* DamageCauser);
+
+	/**
+	 * Spawn this projectile's hit particle and sound locally (callable on the class default object, no-op in server builds)
+	 * @param World - World to play the effects in
+	 * @param HitLocation - Location where projectile hit
+	 * @param HitNormal - Normal vector of the hit surface
+	 */
+	void PlayHitEffects(UWorld* World, const FVector& HitLocation, const FVector& HitNormal) const;
+
+	/**
+	 * Sweep part of this projectile's flight (callable on the class default object)
+	 * Uses the collision component's object type and channel responses, so shots simulated without
+	 * a projectile actor block on what the actor would and pass through overlap-only triggers
+	 * @param World - World to sweep in
+	 * @param Start - Sweep start
+	 * @param End - Sweep end
+	 * @param QueryParams - Ignored actors and stat name
+	 * @param OutHit - First blocking hit
+	 * @return True if something was hit
+	 */
+	bool SweepFlight(const UWorld* World, const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams, FHitResult& OutHit) const;
+
+	/** Radius of the collision sphere (callable on the class default object) */
+	float GetCollisionRadius() const;
+
+	// ========================================================================================
+	// Pooling
+	// ========================================================================================
+
+	/**
+	 * Mark this projectile as owned by a pool (call before FinishSpawning)
+	 * @param InPool - Pool the projectile is returned to instead of being destroyed
+	 */
+	void SetOwningPool(UProjectilePoolSubsystem* InPool) { OwningPool = InPool; }
+
+	/**
+	 * Reset movement/collision state and make the projectile live again (server only)
+	 * @param Location - World location to place the projectile at
+	 * @param Rotation - World rotation to place the projectile with
+	 * @param NewOwner - New owner actor
+	 * @param NewInstigator - Pawn responsible for damage dealt by this projectile
+	 */
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator);
+
+	/**
+	 * Stop movement, disable collision, hide the projectile and make it net dormant (server only)
+	 */
+	void DeactivateToPool();
+
+	/** Is this projectile currently handed out by its pool? */
+	bool IsActiveInPool() const { return PoolActivationId != 0; }
+
+	/**
+	 * Mark this projectile as a local, visual-only copy (call before FinishSpawning)
+	 * Cosmetic projectiles never replicate or apply damage; they play hit effects and disappear
+	 */
+	void SetCosmeticOnly(bool bInCosmeticOnly);
+
+	/** Is this a local, visual-only projectile? */
+	bool IsCosmeticOnly() const { return bCosmeticOnly; }
+
 protected:
 	// ========================================================================================
 	// Collision Handling
@@ -107,18 +185,22 @@ protected:
 	           FVector NormalImpulse, const FHitResult& Hit);
 
 	/**
-	 * Handle projectile destruction
+	 * Handle projectile destruction (returns pooled projectiles to their pool)
 	 */
 	virtual void OnProjectileDestroy();
 
-	/**
-	 * Multicast RPC - Play hit effects on all clients
-	 * @param HitLocation - Location where projectile hit
-	 * @param HitNormal - Normal vector of the hit surface
-	 */
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastPlayHitEffects(FVector_NetQuantize HitLocation, FVector_NetQuantize HitNormal);
-	void MulticastPlayHitEffects_Implementation(FVector_NetQuantize HitLocation, FVector_NetQuantize HitNormal);
+	/** Called when Lifetime has elapsed since the projectile was fired */
+	void OnLifetimeExpired();
+
+	/** Start the lifetime countdown */
+	void StartLifetimeTimer();
+
+	/** Apply pooled active/inactive state locally (server and clients) */
+	void ApplyPoolActivationState();
+
+	/** Called on clients when the projectile is activated or deactivated by its pool */
+	UFUNCTION()
+	void OnRep_PoolActivationId();
 
 public:
 	// ========================================================================================
@@ -132,5 +214,24 @@ public:
 	/** Sound to play on hit */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile|Effects")
 	class USoundBase* HitSound;
+
+private:
+	/** Pool that owns this projectile (null for projectiles spawned directly) */
+	UPROPERTY(Transient)
+	UProjectilePoolSubsystem* OwningPool;
+
+	/**
+	 * Pool activation counter (replicated)
+	 * 0 while sitting in the pool, otherwise changes on every activation so clients
+	 * reset the projectile even if it was recycled between two net updates
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_PoolActivationId)
+	uint8 PoolActivationId;
+
+	/** Local, visual-only projectile (client-simulated shots) */
+	bool bCosmeticOnly;
+
+	/** Timer handle for lifetime expiry */
+	FTimerHandle LifetimeTimerHandle;
 };
 
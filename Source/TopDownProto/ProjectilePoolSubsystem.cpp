@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectilePoolSubsystem.h"
+#include "Projectile.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CVarProjectilePoolStats(
+	TEXT("TopDown.ProjectilePool.Stats"),
+	TEXT("Log projectile pool size, high-water mark and miss counters for the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UProjectilePoolSubsystem* Pool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr)
+		{
+			Pool->LogStats();
+		}
+	})
+);
+
+bool UProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectilePoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Only the server spawns authoritative projectiles
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	for (const TSoftClassPtr<AProjectile>& SoftClass : PrewarmClasses)
+	{
+		if (TSubclassOf<AProjectile> ProjectileClass = SoftClass.LoadSynchronous())
+		{
+			Prewarm(ProjectileClass);
+		}
+	}
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	LogStats();
+	Buckets.Empty();
+	CosmeticBuckets.Empty();
+	TotalNumActive = 0;
+	TotalHighWaterMark = 0;
+
+	Super::Deinitialize();
+}
+
+// ========================================================================================
+// Pool Access
+// ========================================================================================
+
+void UProjectilePoolSubsystem::Prewarm(TSubclassOf<AProjectile> ProjectileClass, int32 Count, bool bCosmetic)
+{
+	if (!ProjectileClass)
+	{
+		return;
+	}
+
+	FProjectilePoolBucket& Bucket = GetBuckets(bCosmetic).FindOrAdd(ProjectileClass);
+	const int32 TargetSize = FMath::Min(Count == INDEX_NONE ? PrewarmCountPerClass : Count, MaxPoolSizePerClass);
+
+	while (Bucket.Stats.PoolSize < TargetSize)
+	{
+		AProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, bCosmetic);
+		if (!Projectile)
+		{
+			break;
+		}
+
+		Bucket.FreeProjectiles.Add(Projectile);
+		Bucket.Stats.PoolSize++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Projectile pool pre-warmed %s%s: %d projectiles"),
+	       *GetNameSafe(ProjectileClass), bCosmetic ? TEXT(" (cosmetic)") : TEXT(""), Bucket.Stats.PoolSize);
+}
+
+AProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FVector& Location,
+                                                         const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator,
+                                                         bool bCosmetic)
+{
+	if (!ProjectileClass)
+	{
+		return nullptr;
+	}
+
+	FProjectilePoolBucket& Bucket = GetBuckets(bCosmetic).FindOrAdd(ProjectileClass);
+
+	// Pop until we find a projectile that wasn't destroyed behind our back (e.g. level streaming)
+	AProjectile* Projectile = nullptr;
+	while (!Projectile && Bucket.FreeProjectiles.Num() > 0)
+	{
+		Projectile = Bucket.FreeProjectiles.Pop(EAllowShrinking::No);
+		if (!IsValid(Projectile))
+		{
+			Projectile = nullptr;
+			Bucket.Stats.PoolSize--;
+		}
+	}
+
+	// Pool empty - grow it
+	if (!Projectile)
+	{
+		Bucket.Stats.Misses++;
+
+		Projectile = SpawnPooledProjectile(ProjectileClass, bCosmetic);
+		if (!Projectile)
+		{
+			return nullptr;
+		}
+
+		Bucket.Stats.PoolSize++;
+	}
+
+	Bucket.Stats.NumActive++;
+	Bucket.Stats.HighWaterMark = FMath::Max(Bucket.Stats.HighWaterMark, Bucket.Stats.NumActive);
+	TotalNumActive++;
+	TotalHighWaterMark = FMath::Max(TotalHighWaterMark, TotalNumActive);
+
+	Projectile->ActivateFromPool(Location, Rotation, NewOwner, NewInstigator);
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(AProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || !Projectile->IsActiveInPool())
+	{
+		return;
+	}
+
+	FProjectilePoolBucket& Bucket = GetBuckets(Projectile->IsCosmeticOnly()).FindOrAdd(Projectile->GetClass());
+	Bucket.Stats.NumActive = FMath::Max(0, Bucket.Stats.NumActive - 1);
+	TotalNumActive = FMath::Max(0, TotalNumActive - 1);
+
+	// Pool is over budget - let this one go
+	if (Bucket.FreeProjectiles.Num() >= MaxPoolSizePerClass)
+	{
+		Bucket.Stats.PoolSize--;
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->DeactivateToPool();
+	Bucket.FreeProjectiles.Add(Projectile);
+}
+
+AProjectile* UProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<AProjectile> ProjectileClass, bool bCosmetic)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Defer spawning so the projectile knows it is pooled before BeginPlay runs
+	AProjectile* Projectile = World->SpawnActorDeferred<AProjectile>(
+		ProjectileClass,
+		FTransform::Identity,
+		nullptr,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+
+	if (!Projectile)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Projectile pool failed to spawn %s"), *GetNameSafe(ProjectileClass));
+		return nullptr;
+	}
+
+	Projectile->SetOwningPool(this);
+	Projectile->SetCosmeticOnly(bCosmetic);
+	Projectile->FinishSpawning(FTransform::Identity);
+	Projectile->DeactivateToPool();
+
+	return Projectile;
+}
+
+// ========================================================================================
+// Stats
+// ========================================================================================
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetStatsForClass(TSubclassOf<AProjectile> ProjectileClass) const
+{
+	const FProjectilePoolBucket* Bucket = Buckets.Find(ProjectileClass);
+	if (!Bucket)
+	{
+		Bucket = CosmeticBuckets.Find(ProjectileClass);
+	}
+	return Bucket ? Bucket->Stats : FProjectilePoolStats();
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetTotalStats() const
+{
+	FProjectilePoolStats Total;
+	for (const TMap<TSubclassOf<AProjectile>, FProjectilePoolBucket>* BucketMap : { &Buckets, &CosmeticBuckets })
+	{
+		for (const TPair<TSubclassOf<AProjectile>, FProjectilePoolBucket>& Pair : *BucketMap)
+		{
+			Total.PoolSize += Pair.Value.Stats.PoolSize;
+			Total.NumActive += Pair.Value.Stats.NumActive;
+			Total.Misses += Pair.Value.Stats.Misses;
+		}
+	}
+	Total.HighWaterMark = TotalHighWaterMark;
+	return Total;
+}
+
+void UProjectilePoolSubsystem::LogStats() const
+{
+	for (const TMap<TSubclassOf<AProjectile>, FProjectilePoolBucket>* BucketMap : { &Buckets, &CosmeticBuckets })
+	{
+		const TCHAR* Suffix = (BucketMap == &CosmeticBuckets) ? TEXT(" (cosmetic)") : TEXT("");
+		for (const TPair<TSubclassOf<AProjectile>, FProjectilePoolBucket>& Pair : *BucketMap)
+		{
+			const FProjectilePoolStats& Stats = Pair.Value.Stats;
+			UE_LOG(LogTemp, Log, TEXT("Projectile pool %s%s: size %d, active %d, high-water %d, misses %d"),
+			       *GetNameSafe(Pair.Key), Suffix, Stats.PoolSize, Stats.NumActive, Stats.HighWaterMark, Stats.Misses);
+		}
+	}
+}
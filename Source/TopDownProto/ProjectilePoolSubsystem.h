@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class AProjectile;
+
+/**
+ * FProjectilePoolStats
+ *
+ * Sizing counters for a projectile pool (per class or totalled across classes).
+ */
+USTRUCT(BlueprintType)
+struct FProjectilePoolStats
+{
+	GENERATED_BODY()
+
+	/** Number of projectile actors owned by the pool (free + active) */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 PoolSize = 0;
+
+	/** Number of projectiles currently handed out */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 NumActive = 0;
+
+	/** Highest number of projectiles that were active at the same time */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 HighWaterMark = 0;
+
+	/** Number of acquires that found no free projectile and had to spawn one */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 Misses = 0;
+};
+
+/**
+ * FProjectilePoolBucket
+ *
+ * Free list and counters for a single projectile class.
+ */
+USTRUCT()
+struct FProjectilePoolBucket
+{
+	GENERATED_BODY()
+
+	/** Inactive projectiles ready to be handed out */
+	UPROPERTY()
+	TArray<AProjectile*> FreeProjectiles;
+
+	/** Sizing counters for this class */
+	UPROPERTY()
+	FProjectilePoolStats Stats;
+};
+
+/**
+ * UProjectilePoolSubsystem
+ *
+ * World subsystem that recycles projectile actors instead of spawning and
+ * destroying one per shot.
+ *
+ * Features:
+ * - Pre-warms configured projectile classes at map load (server only)
+ * - Keeps separate local, non-replicated projectiles for client-simulated shots
+ * - Hands out projectiles on fire and takes them back on hit/lifetime expiry
+ * - Grows on demand when empty (counted as a miss) up to MaxPoolSizePerClass
+ * - Pool size, high-water mark and miss counters for per-map sizing
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	// ========================================================================================
+	// Pool Access
+	// ========================================================================================
+
+	/**
+	 * Make sure at least Count inactive projectiles of the given class exist
+	 * @param ProjectileClass - Class to pre-warm
+	 * @param Count - Minimum number of pooled projectiles for this class (INDEX_NONE uses PrewarmCountPerClass)
+	 * @param bCosmetic - Pre-warm local, non-replicated projectiles used for client-simulated shots
+	 */
+	void Prewarm(TSubclassOf<AProjectile> ProjectileClass, int32 Count = INDEX_NONE, bool bCosmetic = false);
+
+	/**
+	 * Take a projectile out of the pool and place it at the given transform
+	 * Spawns a new projectile if the pool for this class is empty
+	 * @param ProjectileClass - Class of projectile to acquire
+	 * @param Location - World location to activate the projectile at
+	 * @param Rotation - World rotation to activate the projectile with
+	 * @param NewOwner - Owner of the projectile (usually the firing character)
+	 * @param NewInstigator - Pawn responsible for damage dealt by the projectile
+	 * @param bCosmetic - Acquire a local, non-replicated projectile that never applies damage
+	 * @return Active projectile, or nullptr if one could not be spawned
+	 */
+	AProjectile* AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation,
+	                               AActor* NewOwner, APawn* NewInstigator, bool bCosmetic = false);
+
+	/**
+	 * Return a projectile to the pool (destroys it if the pool is full)
+	 * @param Projectile - Projectile previously handed out by AcquireProjectile
+	 */
+	void ReleaseProjectile(AProjectile* Projectile);
+
+	// ========================================================================================
+	// Stats
+	// ========================================================================================
+
+	/** Get counters for a single projectile class */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	FProjectilePoolStats GetStatsForClass(TSubclassOf<AProjectile> ProjectileClass) const;
+
+	/** Get counters summed over all projectile classes (high-water mark is the peak of the total) */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	FProjectilePoolStats GetTotalStats() const;
+
+	/** Write per-class counters to the log */
+	void LogStats() const;
+
+protected:
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Projectile classes to pre-warm when the map begins play */
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<AProjectile>> PrewarmClasses;
+
+	/** Number of projectiles to pre-warm per class */
+	UPROPERTY(Config)
+	int32 PrewarmCountPerClass = 64;
+
+	/** Upper bound on pooled projectiles per class (extra returns are destroyed) */
+	UPROPERTY(Config)
+	int32 MaxPoolSizePerClass = 512;
+
+private:
+	/** Spawn a new inactive projectile owned by this pool */
+	AProjectile* SpawnPooledProjectile(TSubclassOf<AProjectile> ProjectileClass, bool bCosmetic);
+
+	/** Get the bucket map for replicated or cosmetic projectiles */
+	TMap<TSubclassOf<AProjectile>, FProjectilePoolBucket>& GetBuckets(bool bCosmetic) { return bCosmetic ? CosmeticBuckets : Buckets; }
+
+	/** Per-class free lists and counters for replicated projectiles */
+	UPROPERTY()
+	TMap<TSubclassOf<AProjectile>, FProjectilePoolBucket> Buckets;
+
+	/** Per-class free lists and counters for local cosmetic projectiles */
+	UPROPERTY()
+	TMap<TSubclassOf<AProjectile>, FProjectilePoolBucket> CosmeticBuckets;
+
+	/** Projectiles handed out across every class, and the most at once (per-class peaks don't add up) */
+	int32 TotalNumActive = 0;
+	int32 TotalHighWaterMark = 0;
+};
@@ -0,0 +1,509 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpatialGridSubsystem.h"
+#include "TopDownStats.h"
+#include "TopDownCharacter.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CVarSpatialGridBenchmark(
+	TEXT("TopDown.SpatialGrid.Benchmark"),
+	TEXT("Compare spatial grid queries against actor iteration. Optional args: character counts (default 16 64 256)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USpatialGridSubsystem* SpatialGrid = World ? World->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+		if (!SpatialGrid)
+		{
+			return;
+		}
+
+		TArray<int32> CharacterCounts;
+		for (const FString& Arg : Args)
+		{
+			CharacterCounts.Add(FCString::Atoi(*Arg));
+		}
+		if (CharacterCounts.Num() == 0)
+		{
+			CharacterCounts = { 16, 64, 256 };
+		}
+
+		SpatialGrid->RunBenchmark(CharacterCounts);
+	})
+);
+
+bool USpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USpatialGridSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+	MovableEntries.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId USpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+// ========================================================================================
+// Registration
+// ========================================================================================
+
+FIntPoint USpatialGridSubsystem::GetCell(const FVector2D& Position) const
+{
+	return FIntPoint(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize));
+}
+
+void USpatialGridSubsystem::AddToCell(int32 EntryIndex)
+{
+	const FIntPoint& Cell = Entries[EntryIndex].Cell;
+	Cells.FindOrAdd(GetCellKey(Cell)).Add(EntryIndex);
+
+	OccupiedMin = FIntPoint(FMath::Min(OccupiedMin.X, Cell.X), FMath::Min(OccupiedMin.Y, Cell.Y));
+	OccupiedMax = FIntPoint(FMath::Max(OccupiedMax.X, Cell.X), FMath::Max(OccupiedMax.Y, Cell.Y));
+}
+
+void USpatialGridSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	const FIntPoint& Cell = Entries[EntryIndex].Cell;
+	const uint64 CellKey = GetCellKey(Cell);
+	if (FCellList* CellList = Cells.Find(CellKey))
+	{
+		CellList->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+		if (CellList->Num() == 0)
+		{
+			Cells.Remove(CellKey);
+
+			// A far cell passed through once must not widen every nearest search for good
+			if (Cell.X == OccupiedMin.X || Cell.X == OccupiedMax.X || Cell.Y == OccupiedMin.Y || Cell.Y == OccupiedMax.Y)
+			{
+				bOccupiedBoundsDirty = true;
+			}
+		}
+	}
+}
+
+void USpatialGridSubsystem::RecomputeOccupiedBounds()
+{
+	OccupiedMin = FIntPoint(MAX_int32, MAX_int32);
+	OccupiedMax = FIntPoint(MIN_int32, MIN_int32);
+	for (const TPair<uint64, FCellList>& CellPair : Cells)
+	{
+		const FIntPoint Cell(static_cast<int32>(uint32(CellPair.Key >> 32)), static_cast<int32>(uint32(CellPair.Key)));
+		OccupiedMin = FIntPoint(FMath::Min(OccupiedMin.X, Cell.X), FMath::Min(OccupiedMin.Y, Cell.Y));
+		OccupiedMax = FIntPoint(FMath::Max(OccupiedMax.X, Cell.X), FMath::Max(OccupiedMax.Y, Cell.Y));
+	}
+	bOccupiedBoundsDirty = false;
+}
+
+void USpatialGridSubsystem::RefreshEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	const AActor* Actor = Entry.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+	Entry.Position = FVector2D(Actor->GetActorLocation());
+
+	const FIntPoint NewCell = GetCell(Entry.Position);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(EntryIndex);
+		Entry.Cell = NewCell;
+		AddToCell(EntryIndex);
+	}
+}
+
+void USpatialGridSubsystem::RemoveEntry(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+	if (Entry.bMovable)
+	{
+		MovableEntries.RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	}
+	EntryIndices.Remove(Entry.ActorKey);
+	RemoveFromCell(EntryIndex);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void USpatialGridSubsystem::RegisterActor(AActor* Actor, ESpatialGridCategory Category)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (const int32* ExistingIndex = EntryIndices.Find(Actor))
+	{
+		// A destroyed actor that never unregistered may share this address
+		if (Entries[*ExistingIndex].Actor.IsValid())
+		{
+			return;
+		}
+		RemoveEntry(*ExistingIndex);
+	}
+
+	const USceneComponent* Root = Actor->GetRootComponent();
+
+	FEntry NewEntry;
+	NewEntry.Actor = Actor;
+	NewEntry.ActorKey = Actor;
+	NewEntry.Position = FVector2D(Actor->GetActorLocation());
+	NewEntry.Cell = GetCell(NewEntry.Position);
+	NewEntry.Category = Category;
+	NewEntry.bMovable = Root && Root->Mobility == EComponentMobility::Movable;
+
+	const int32 EntryIndex = Entries.Add(NewEntry);
+	EntryIndices.Add(Actor, EntryIndex);
+	AddToCell(EntryIndex);
+
+	if (NewEntry.bMovable)
+	{
+		MovableEntries.Add(EntryIndex);
+	}
+}
+
+void USpatialGridSubsystem::UnregisterActor(const AActor* Actor)
+{
+	if (const int32* EntryIndex = EntryIndices.Find(Actor))
+	{
+		RemoveEntry(*EntryIndex);
+	}
+}
+
+void USpatialGridSubsystem::UpdateActor(const AActor* Actor)
+{
+	if (const int32* EntryIndex = EntryIndices.Find(Actor))
+	{
+		RefreshEntry(*EntryIndex);
+	}
+}
+
+void USpatialGridSubsystem::Tick(float DeltaTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(SpatialGridUpdate);
+
+	Super::Tick(DeltaTime);
+
+	// Only movable actors can change cell on their own; most of them stay inside their cell between frames.
+	// Walk backwards so pruning an actor destroyed without unregistering doesn't skip the swapped-in entry
+	for (int32 Index = MovableEntries.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 EntryIndex = MovableEntries[Index];
+		if (IsValid(Entries[EntryIndex].Actor.Get()))
+		{
+			RefreshEntry(EntryIndex);
+		}
+		else
+		{
+			RemoveEntry(EntryIndex);
+		}
+	}
+
+	// Once per frame at most, however many boundary cells emptied
+	if (bOccupiedBoundsDirty)
+	{
+		RecomputeOccupiedBounds();
+	}
+}
+
+// ========================================================================================
+// Queries
+// ========================================================================================
+
+void USpatialGridSubsystem::ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell,
+                                                TFunctionRef<void(const FEntry&)> Visitor) const
+{
+	const int64 NumCellsInRange = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	// Large ranges over a sparse grid: walking occupied cells is cheaper than probing empty ones
+	if (NumCellsInRange > Cells.Num())
+	{
+		for (const TPair<uint64, FCellList>& CellPair : Cells)
+		{
+			for (const int32 EntryIndex : CellPair.Value)
+			{
+				const FEntry& Entry = Entries[EntryIndex];
+				if (Entry.Cell.X >= MinCell.X && Entry.Cell.X <= MaxCell.X && Entry.Cell.Y >= MinCell.Y && Entry.Cell.Y <= MaxCell.Y)
+				{
+					Visitor(Entry);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const FCellList* CellList = Cells.Find(GetCellKey(FIntPoint(X, Y))))
+			{
+				for (const int32 EntryIndex : *CellList)
+				{
+					Visitor(Entries[EntryIndex]);
+				}
+			}
+		}
+	}
+}
+
+void USpatialGridSubsystem::ForEachInRadius(const FVector& Center, float Radius, ESpatialGridCategory Categories,
+                                            TFunctionRef<void(AActor*, float)> Visitor) const
+{
+	const FVector2D Center2D(Center);
+	const float RadiusSq = Radius * Radius;
+
+	ForEachEntryInCells(GetCell(Center2D - FVector2D(Radius)), GetCell(Center2D + FVector2D(Radius)),
+		[&](const FEntry& Entry)
+		{
+			if (EnumHasAnyFlags(Entry.Category, Categories))
+			{
+				const float DistSq = FVector2D::DistSquared(Entry.Position, Center2D);
+				if (DistSq <= RadiusSq)
+				{
+					if (AActor* Actor = Entry.Actor.Get())
+					{
+						Visitor(Actor, DistSq);
+					}
+				}
+			}
+		});
+}
+
+void USpatialGridSubsystem::ForEachInBox(const FBox2D& Box, ESpatialGridCategory Categories, TFunctionRef<void(AActor*)> Visitor) const
+{
+	ForEachEntryInCells(GetCell(Box.Min), GetCell(Box.Max),
+		[&](const FEntry& Entry)
+		{
+			if (EnumHasAnyFlags(Entry.Category, Categories) && Box.IsInsideOrOn(Entry.Position))
+			{
+				if (AActor* Actor = Entry.Actor.Get())
+				{
+					Visitor(Actor);
+				}
+			}
+		});
+}
+
+int32 USpatialGridSubsystem::FindNearest(const FVector& Center, ESpatialGridCategory Categories, TArrayView<FSpatialGridHit> OutHits,
+                                         TFunctionRef<bool(const AActor*)> Filter, float MaxRadius) const
+{
+	const int32 MaxHits = OutHits.Num();
+	if (MaxHits == 0 || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVector2D Center2D(Center);
+	const FIntPoint CenterCell = GetCell(Center2D);
+	const float MaxRadiusSq = MaxRadius * MaxRadius;
+	int32 NumHits = 0;
+
+	// Insert into OutHits keeping it sorted nearest first (K is small, so insertion sort)
+	auto ConsiderEntry = [&](const FEntry& Entry)
+	{
+		if (!EnumHasAnyFlags(Entry.Category, Categories))
+		{
+			return;
+		}
+
+		const float DistSq = FVector2D::DistSquared(Entry.Position, Center2D);
+		if (DistSq > MaxRadiusSq || (NumHits == MaxHits && DistSq >= OutHits[MaxHits - 1].DistSq))
+		{
+			return;
+		}
+
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor || !Filter(Actor))
+		{
+			return;
+		}
+
+		int32 InsertIndex = FMath::Min(NumHits, MaxHits - 1);
+		while (InsertIndex > 0 && OutHits[InsertIndex - 1].DistSq > DistSq)
+		{
+			OutHits[InsertIndex] = OutHits[InsertIndex - 1];
+			--InsertIndex;
+		}
+		OutHits[InsertIndex] = { Actor, DistSq };
+		NumHits = FMath::Min(NumHits + 1, MaxHits);
+	};
+
+	auto VisitCell = [&](int32 X, int32 Y)
+	{
+		if (const FCellList* CellList = Cells.Find(GetCellKey(FIntPoint(X, Y))))
+		{
+			for (const int32 EntryIndex : *CellList)
+			{
+				ConsiderEntry(Entries[EntryIndex]);
+			}
+		}
+	};
+
+	// Expand square rings of cells around the center until nothing closer can remain
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(CenterCell.X - OccupiedMin.X), FMath::Abs(OccupiedMax.X - CenterCell.X)),
+		FMath::Max(FMath::Abs(CenterCell.Y - OccupiedMin.Y), FMath::Abs(OccupiedMax.Y - CenterCell.Y)));
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Ring == 0)
+		{
+			VisitCell(CenterCell.X, CenterCell.Y);
+		}
+		else
+		{
+			for (int32 Offset = -Ring; Offset <= Ring; ++Offset)
+			{
+				VisitCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+				VisitCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+			}
+			for (int32 Offset = -Ring + 1; Offset <= Ring - 1; ++Offset)
+			{
+				VisitCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+				VisitCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+			}
+		}
+
+		// Anything in the next ring is at least Ring cells away
+		const float NextRingDist = Ring * CellSize;
+		const float NextRingDistSq = NextRingDist * NextRingDist;
+		if (NextRingDistSq > MaxRadiusSq || (NumHits == MaxHits && OutHits[MaxHits - 1].DistSq <= NextRingDistSq))
+		{
+			break;
+		}
+	}
+
+	return NumHits;
+}
+
+// ========================================================================================
+// Benchmark
+// ========================================================================================
+
+void USpatialGridSubsystem::RunBenchmark(const TArray<int32>& CharacterCounts)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Spatial grid benchmark must run with authority"));
+		return;
+	}
+
+	constexpr int32 NumProbes = 32;
+	constexpr int32 NumIterations = 100;
+	constexpr float ArenaHalfExtent = 10000.0f;
+	constexpr float QueryRadius = 1500.0f;
+
+	FRandomStream Random(12345);
+	TArray<FVector> Probes;
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		Probes.Add(FVector(Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), 0.0f));
+	}
+
+	for (const int32 CharacterCount : CharacterCounts)
+	{
+		// Populate the world with characters scattered across the arena
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<AActor*> Spawned;
+		for (int32 Index = 0; Index < CharacterCount; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), 100.0f);
+			if (AActor* Character = World->SpawnActor<ATopDownCharacter>(ATopDownCharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams))
+			{
+				Spawned.Add(Character);
+			}
+		}
+
+		// Nearest character: actor iteration (current FindPlayerStart path) vs. grid
+		// (compared by which character was found; float distance sums drift apart over thousands of queries)
+		TArray<const AActor*> IteratorNearest;
+		IteratorNearest.Init(nullptr, NumProbes);
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 ProbeIndex = 0; ProbeIndex < NumProbes; ++ProbeIndex)
+			{
+				double MinDistSq = MAX_dbl;
+				for (TActorIterator<ATopDownCharacter> It(World); It; ++It)
+				{
+					const double DistSq = FVector::DistSquared2D(Probes[ProbeIndex], It->GetActorLocation());
+					if (DistSq < MinDistSq)
+					{
+						MinDistSq = DistSq;
+						IteratorNearest[ProbeIndex] = *It;
+					}
+				}
+			}
+		}
+		const double IteratorNearestMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		TArray<const AActor*> GridNearest;
+		GridNearest.Init(nullptr, NumProbes);
+		StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 ProbeIndex = 0; ProbeIndex < NumProbes; ++ProbeIndex)
+			{
+				FSpatialGridHit Nearest;
+				if (FindNearest(Probes[ProbeIndex], ESpatialGridCategory::Character, MakeArrayView(&Nearest, 1), [](const AActor*) { return true; }) > 0)
+				{
+					GridNearest[ProbeIndex] = Nearest.Actor;
+				}
+			}
+		}
+		const double GridNearestMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		// Radius query: actor iteration vs. grid
+		int32 IteratorFound = 0;
+		StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FVector& Probe : Probes)
+			{
+				for (TActorIterator<ATopDownCharacter> It(World); It; ++It)
+				{
+					IteratorFound += FVector::DistSquared2D(Probe, It->GetActorLocation()) <= QueryRadius * QueryRadius ? 1 : 0;
+				}
+			}
+		}
+		const double IteratorRadiusMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		int32 GridFound = 0;
+		StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FVector& Probe : Probes)
+			{
+				ForEachInRadius(Probe, QueryRadius, ESpatialGridCategory::Character, [&GridFound](AActor*, float) { ++GridFound; });
+			}
+		}
+		const double GridRadiusMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		const double NumQueries = static_cast<double>(NumIterations * NumProbes);
+		UE_LOG(LogTemp, Log, TEXT("Spatial grid benchmark: %d characters | nearest: iterator %.3f us, grid %.3f us (%s) | radius: iterator %.3f us, grid %.3f us (%s)"),
+		       Spawned.Num(),
+		       IteratorNearestMs * 1000.0 / NumQueries, GridNearestMs * 1000.0 / NumQueries,
+		       IteratorNearest == GridNearest ? TEXT("match") : TEXT("MISMATCH"),
+		       IteratorRadiusMs * 1000.0 / NumQueries, GridRadiusMs * 1000.0 / NumQueries,
+		       IteratorFound == GridFound ? TEXT("match") : TEXT("MISMATCH"));
+
+		for (AActor* Character : Spawned)
+		{
+			Character->Destroy();
+		}
+	}
+}
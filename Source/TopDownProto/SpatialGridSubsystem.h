@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialGridSubsystem.generated.h"
+
+/**
+ * ESpatialGridCategory
+ *
+ * Kinds of actors tracked by the spatial grid (bit flags so queries can ask for several)
+ */
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ESpatialGridCategory : uint8
+{
+	None         = 0,
+	Character    = 1 << 0,
+	Projectile   = 1 << 1,
+	All          = Character | Projectile
+};
+ENUM_CLASS_FLAGS(ESpatialGridCategory);
+
+/**
+ * FSpatialGridHit
+ *
+ * Single result of a nearest-neighbour query.
+ */
+struct FSpatialGridHit
+{
+	/** Actor found */
+	AActor* Actor = nullptr;
+
+	/** Squared 2D distance to the query point */
+	float DistSq = 0.0f;
+};
+
+/**
+ * USpatialGridSubsystem
+ *
+ * 2D uniform spatial hash of characters and projectiles.
+ * The game is constrained to the XY plane, so Z is ignored.
+ *
+ * Features:
+ * - Incremental maintenance: only movable actors are polled each tick, and re-bucketed only when they change cell
+ * - Actors are held weakly; one destroyed without unregistering is skipped by queries and pruned
+ * - Radius, box and k-nearest queries
+ * - Allocation-free iteration through callbacks (TFunctionRef) and caller-provided result storage
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API USpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// ========================================================================================
+	// Registration
+	// ========================================================================================
+
+	/**
+	 * Start tracking an actor
+	 * @param Actor - Actor to track (should unregister before it is destroyed)
+	 * @param Category - What kind of actor this is
+	 * @note Actors whose root is not movable are not polled; call UpdateActor after moving one
+	 */
+	void RegisterActor(AActor* Actor, ESpatialGridCategory Category);
+
+	/** Stop tracking an actor */
+	void UnregisterActor(const AActor* Actor);
+
+	/** Re-bucket a single actor right away (e.g. after a teleport, or any move of a non-movable actor) */
+	void UpdateActor(const AActor* Actor);
+
+	/** Get number of tracked actors */
+	int32 GetNumActors() const { return Entries.Num(); }
+
+	// ========================================================================================
+	// Queries
+	// ========================================================================================
+
+	/**
+	 * Visit every tracked actor within Radius of Center
+	 * @param Center - Query center (Z ignored)
+	 * @param Radius - Query radius
+	 * @param Categories - Kinds of actors to visit
+	 * @param Visitor - Called with each actor and its squared 2D distance to Center
+	 */
+	void ForEachInRadius(const FVector& Center, float Radius, ESpatialGridCategory Categories,
+	                     TFunctionRef<void(AActor*, float)> Visitor) const;
+
+	/**
+	 * Visit every tracked actor inside an axis-aligned box
+	 * @param Box - Query box in world XY
+	 * @param Categories - Kinds of actors to visit
+	 * @param Visitor - Called with each actor
+	 */
+	void ForEachInBox(const FBox2D& Box, ESpatialGridCategory Categories, TFunctionRef<void(AActor*)> Visitor) const;
+
+	/**
+	 * Find the nearest tracked actors to a point
+	 * @param Center - Query point (Z ignored)
+	 * @param Categories - Kinds of actors to consider
+	 * @param OutHits - Caller-provided storage; its size is K. Filled nearest first
+	 * @param Filter - Return false to skip an actor
+	 * @param MaxRadius - Ignore actors further than this
+	 * @return Number of hits written to OutHits
+	 */
+	int32 FindNearest(const FVector& Center, ESpatialGridCategory Categories, TArrayView<FSpatialGridHit> OutHits,
+	                  TFunctionRef<bool(const AActor*)> Filter, float MaxRadius = UE_BIG_NUMBER) const;
+
+	/** Run the grid vs. actor-iterator benchmark (TopDown.SpatialGrid.Benchmark) */
+	void RunBenchmark(const TArray<int32>& CharacterCounts);
+
+protected:
+	/** Size of one grid cell in world units */
+	UPROPERTY(Config)
+	float CellSize = 1000.0f;
+
+private:
+	/** Tracked actor */
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		const AActor* ActorKey = nullptr;     // EntryIndices key only, never dereferenced
+		FVector2D Position = FVector2D::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		ESpatialGridCategory Category = ESpatialGridCategory::None;
+		bool bMovable = false;
+	};
+
+	/** Entry indices per cell */
+	using FCellList = TArray<int32, TInlineAllocator<8>>;
+
+	FIntPoint GetCell(const FVector2D& Position) const;
+	static uint64 GetCellKey(const FIntPoint& Cell) { return (uint64(uint32(Cell.X)) << 32) | uint64(uint32(Cell.Y)); }
+
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+	void RefreshEntry(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+
+	/** Shrink the occupied bounds to the cells that still hold entries */
+	void RecomputeOccupiedBounds();
+
+	/** Visit the entries of every occupied cell in an inclusive cell range */
+	void ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, TFunctionRef<void(const FEntry&)> Visitor) const;
+
+	/** Tracked actors, indices stay stable across removals */
+	TSparseArray<FEntry> Entries;
+
+	/** Actor to entry index */
+	TMap<const AActor*, int32> EntryIndices;
+
+	/** Entries polled each tick (movable root component) */
+	TArray<int32> MovableEntries;
+
+	/** Cell key to entries in that cell */
+	TMap<uint64, FCellList> Cells;
+
+	/** Bounds of the occupied cells (limits k-nearest ring expansion); may be wider until the next tick after a boundary cell empties */
+	FIntPoint OccupiedMin = FIntPoint(MAX_int32, MAX_int32);
+	FIntPoint OccupiedMax = FIntPoint(MIN_int32, MIN_int32);
+	bool bOccupiedBoundsDirty = false;
+};
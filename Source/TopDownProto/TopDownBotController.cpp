@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownBotController.h"
+#include "TopDownCharacter.h"
+#include "WeaponComponent.h"
+#include "SpatialGridSubsystem.h"
+#include "Camera/CameraComponent.h"
+#include "Engine/World.h"
+
+ATopDownBotController::ATopDownBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// Bots show up in the player array like players (kills, scores, lag compensation lookups)
+	bWantsPlayerState = true;
+
+	WanderGoal = FVector::ZeroVector;
+	NextDecisionTime = 0.0f;
+	bTriggerHeld = false;
+	bFireContinuously = false;
+}
+
+void ATopDownBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	Random.Initialize(static_cast<int32>(GetUniqueID()));
+	Target.Reset();
+	WanderGoal = InPawn ? InPawn->GetActorLocation() : FVector::ZeroVector;
+	NextDecisionTime = 0.0f;
+
+	// A respawned character starts with the trigger released
+	bTriggerHeld = false;
+}
+
+void ATopDownBotController::OnUnPossess()
+{
+	if (ATopDownCharacter* Bot = Cast<ATopDownCharacter>(GetPawn()))
+	{
+		SetTrigger(Bot, false);
+	}
+
+	Super::OnUnPossess();
+}
+
+void ATopDownBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ATopDownCharacter* Bot = Cast<ATopDownCharacter>(GetPawn());
+	if (!Bot || Bot->IsDead() || Bot->IsPooled())
+	{
+		bTriggerHeld = false;
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (Now >= NextDecisionTime)
+	{
+		// Spread decisions so bots spawned on the same frame don't all think on the same frame
+		NextDecisionTime = Now + DecisionInterval * Random.FRandRange(0.8f, 1.2f);
+		Think(Bot);
+	}
+
+	Steer(Bot);
+}
+
+// ========================================================================================
+// Behaviour
+// ========================================================================================
+
+void ATopDownBotController::Think(ATopDownCharacter* Bot)
+{
+	const FVector BotLocation = Bot->GetActorLocation();
+
+	// Nearest living enemy
+	Target.Reset();
+	if (const USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		FSpatialGridHit Nearest;
+		const int32 NumHits = SpatialGrid->FindNearest(BotLocation, ESpatialGridCategory::Character, MakeArrayView(&Nearest, 1),
+			[Bot](const AActor* Candidate)
+			{
+				const ATopDownCharacter* Character = Cast<ATopDownCharacter>(Candidate);
+				return Character && Character != Bot && !Character->IsDead() && !Character->IsPooled();
+			});
+
+		if (NumHits > 0)
+		{
+			Target = Cast<ATopDownCharacter>(Nearest.Actor);
+		}
+	}
+
+	// New wander goal once the old one is reached
+	if (FVector::DistSquared2D(BotLocation, WanderGoal) < FMath::Square(WanderAcceptRadius))
+	{
+		const FVector2D Offset = FVector2D(Random.VRand()).GetSafeNormal() * Random.FRandRange(0.3f, 1.0f) * WanderRadius;
+		WanderGoal = BotLocation + FVector(Offset, 0.0f);
+	}
+
+	UWeaponComponent* Weapon = Bot->GetWeaponComponent();
+
+	// Benchmark bots never stop shooting; refill once both magazine and reserve are spent
+	if (bFireContinuously)
+	{
+		if (Weapon && !Weapon->HasAmmo() && !Weapon->HasReserveAmmo())
+		{
+			Weapon->ResetAmmo();
+		}
+		SetTrigger(Bot, true);
+		return;
+	}
+
+	// Fire at targets in range
+	const bool bInRange = Target.IsValid() && FVector::DistSquared2D(BotLocation, Target->GetActorLocation()) < FMath::Square(EngageRange);
+	SetTrigger(Bot, bInRange);
+
+	// Top up between fights
+	if (!bInRange && Weapon && Weapon->CanReload()
+		&& Weapon->GetCurrentAmmo() < FMath::CeilToInt(Weapon->GetMagazineSize() * ReloadBelowFraction))
+	{
+		Bot->BotReload();
+	}
+}
+
+void ATopDownBotController::Steer(ATopDownCharacter* Bot)
+{
+	const FVector BotLocation = Bot->GetActorLocation();
+
+	// Face the target (the auto-fire loop shoots along the actor's facing)
+	if (const ATopDownCharacter* TargetCharacter = Target.Get())
+	{
+		const FVector ToTarget = (TargetCharacter->GetActorLocation() - BotLocation).GetSafeNormal2D();
+		if (!ToTarget.IsNearlyZero())
+		{
+			Bot->SetActorRotation(FRotator(0.0f, ToTarget.Rotation().Yaw, 0.0f));
+		}
+	}
+
+	// Walk toward the wander goal, expressed in the camera-relative axes Move() expects
+	const FVector ToGoal = (WanderGoal - BotLocation).GetSafeNormal2D();
+	if (ToGoal.IsNearlyZero())
+	{
+		return;
+	}
+
+	const float CameraYaw = Bot->GetTopDownCameraComponent() ? Bot->GetTopDownCameraComponent()->GetComponentRotation().Yaw : 0.0f;
+	const FRotator YawRotation(0.0f, CameraYaw, 0.0f);
+	const FVector Forward = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
+	const FVector Right = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+
+	Bot->BotMove(FVector2D(FVector::DotProduct(ToGoal, Right), FVector::DotProduct(ToGoal, Forward)));
+}
+
+void ATopDownBotController::SetTrigger(ATopDownCharacter* Bot, bool bPressed)
+{
+	if (bTriggerHeld == bPressed)
+	{
+		return;
+	}
+
+	bTriggerHeld = bPressed;
+	Bot->BotSetTrigger(bPressed);
+}
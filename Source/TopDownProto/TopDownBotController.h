@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "TopDownBotController.generated.h"
+
+class ATopDownCharacter;
+
+/**
+ * ATopDownBotController
+ *
+ * Headless load-test bot. Possesses an ATopDownCharacter and drives it through the same
+ * Move, trigger and reload handlers a player's input uses, so the server pays the real cost
+ * of movement, auto-fire, projectiles, damage and respawns.
+ *
+ * Features:
+ * - Wanders between random points around where it is, no navmesh required
+ * - Aims at the nearest living enemy (spatial grid) and holds the trigger while it is in range
+ * - Reloads when out of combat with a low magazine (empty magazines auto-reload)
+ * - Optional continuous fire (perf scenario): trigger always held, ammo never runs out
+ * - Spawned by ATopDownGameMode for -bots=N on a dedicated server (TopDownProtoServer), or TopDown.Bots.Spawn
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API ATopDownBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ATopDownBotController();
+
+	/**
+	 * Hold the trigger the whole time instead of only with an enemy in range, topping ammo up when
+	 * it runs out, so every weapon keeps firing for the length of a benchmark
+	 */
+	void SetFireContinuously(bool bInFireContinuously) { bFireContinuously = bInFireContinuously; }
+
+	//~ Begin AActor Interface
+	virtual void Tick(float DeltaSeconds) override;
+	//~ End AActor Interface
+
+protected:
+	//~ Begin AController Interface
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+	//~ End AController Interface
+
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Seconds between target and wander decisions */
+	UPROPERTY(Config)
+	float DecisionInterval = 0.25f;
+
+	/** Hold the trigger while the target is closer than this */
+	UPROPERTY(Config)
+	float EngageRange = 1500.0f;
+
+	/** Wander goals are picked within this distance of the bot */
+	UPROPERTY(Config)
+	float WanderRadius = 1000.0f;
+
+	/** Pick a new wander goal once this close to the current one */
+	UPROPERTY(Config)
+	float WanderAcceptRadius = 100.0f;
+
+	/** Reload out of combat when the magazine is below this fraction */
+	UPROPERTY(Config)
+	float ReloadBelowFraction = 0.3f;
+
+private:
+	/** Choose a target, a wander goal and the trigger/reload action */
+	void Think(ATopDownCharacter* Bot);
+
+	/** Steer toward the wander goal and face the target (every tick) */
+	void Steer(ATopDownCharacter* Bot);
+
+	/** Press or release the trigger only when the state changes */
+	void SetTrigger(ATopDownCharacter* Bot, bool bPressed);
+
+	/** Enemy currently aimed at */
+	TWeakObjectPtr<ATopDownCharacter> Target;
+
+	/** Point the bot is walking to */
+	FVector WanderGoal;
+
+	/** World time of the next Think */
+	float NextDecisionTime;
+
+	/** Trigger state last sent to the character */
+	bool bTriggerHeld;
+
+	/** Ignore range and ammo limits and keep firing (SetFireContinuously) */
+	bool bFireContinuously;
+
+	/** Per-bot random stream (seeded from the unique id, so runs are repeatable) */
+	FRandomStream Random;
+};
@@ -12,6 +12,7 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/World.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "WeaponComponent.h"
@@ -22,12 +23,60 @@
 #include "TopDownGameMode.h"
 #include "TopDownPlayerController.h"
 #include "TopDownHUD.h"
+#include "LagCompensationSubsystem.h"
+#include "SpatialGridSubsystem.h"
+#include "CosmeticEventSubsystem.h"
+#include "CharacterPoolSubsystem.h"
+#include "TopDownCombatLog.h"
+#include "CombatJournal.h"
+#include "DamageAggregationSubsystem.h"
+#include "TopDownStats.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/DamageEvents.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CVarTopDownTickStats(
+	TEXT("TopDown.Ticks.Stats"),
+	TEXT("Log how many top-down characters, and components on them, have ticking enabled in this world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		int32 NumCharacters = 0;
+		int32 NumActorTicks = 0;
+		int32 NumComponentTicks = 0;
+		int32 NumWeaponTicks = 0;
+		for (TActorIterator<ATopDownCharacter> It(World); It; ++It)
+		{
+			++NumCharacters;
+			NumActorTicks += It->IsActorTickEnabled() ? 1 : 0;
+
+			for (const UActorComponent* Component : It->GetComponents())
+			{
+				if (Component && Component->IsComponentTickEnabled())
+				{
+					++NumComponentTicks;
+					NumWeaponTicks += Component->IsA<UWeaponComponent>() ? 1 : 0;
+				}
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Tick stats (%s): %d characters, %d character ticks, %d component ticks (%d weapon)"),
+		       World->GetNetMode() == NM_Client ? TEXT("client") : TEXT("server"),
+		       NumCharacters, NumActorTicks, NumComponentTicks, NumWeaponTicks);
+	})
+);
 
-ATopDownCharacter::ATopDownCharacter()
+ATopDownCharacter::ATopDownCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UTopDownMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
-	// Set this character to call Tick() every frame
+	// Tick() only does work for the locally controlled player character; UpdateTickEnabled() turns it on there
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Enable replication
 	bReplicates = true;
@@ -77,6 +126,8 @@ ATopDownCharacter::ATopDownCharacter()
 
 	// Initialize firing state
 	bIsFirePressed = false;
+	TriggerShotTime = 0.0f;
+	TriggerFireDelay = 0.0f;
 
 	// Initialize effects (set in Blueprint)
 	MuzzleFlash = nullptr;
@@ -86,6 +137,8 @@ ATopDownCharacter::ATopDownCharacter()
 	MaxHealth = 100.0f;
 	Health = MaxHealth;
 	bIsDead = false;
+	bIsPooled = false;
+	PushDirtyMask = 0;
 
 	// Initialize character
 	InitializeCharacter();
@@ -101,9 +154,79 @@ void ATopDownCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	// Replicate health properties
-	DOREPLIFETIME(ATopDownCharacter, Health);
-	DOREPLIFETIME(ATopDownCharacter, bIsDead);
+	// Replicate health properties (push model - only compared after SetHealth/SetIsDead)
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATopDownCharacter, Health, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATopDownCharacter, bIsDead, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATopDownCharacter, bIsPooled, PushParams);
+
+	// Simulated proxies get planar movement instead of the full 3D FRepMovement
+	DISABLE_REPLICATED_PRIVATE_PROPERTY(AActor, ReplicatedMovement);
+
+	FDoRepLifetimeParams MovementParams;
+	MovementParams.bIsPushBased = true;
+	MovementParams.Condition = COND_SimulatedOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATopDownCharacter, PlanarMovement, MovementParams);
+}
+
+void ATopDownCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(CharacterPreReplication);
+
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// AActor::PreReplication has just gathered ReplicatedMovement; only dirty it when the quantized value moves
+	if (IsReplicatingMovement())
+	{
+		const FTopDownRepMovement NewPlanarMovement = FTopDownRepMovement::FromRepMovement(GetReplicatedMovement());
+		if (PlanarMovement != NewPlanarMovement)
+		{
+			PlanarMovement = NewPlanarMovement;
+			MARK_PROPERTY_DIRTY_FROM_NAME(ATopDownCharacter, PlanarMovement, this);
+			PushDirtyMask |= 1 << 2;
+			INC_DWORD_STAT(STAT_TopDownPushModelDirtyMarks);
+		}
+	}
+
+	// Every push-based property not marked since the last net update is a compare the net driver skips
+	constexpr int32 NumPushProperties = 4;
+	INC_DWORD_STAT_BY(STAT_TopDownPushModelComparesSkipped, NumPushProperties - FMath::CountBits(PushDirtyMask));
+	PushDirtyMask = 0;
+}
+
+void ATopDownCharacter::SetHealth(float NewHealth)
+{
+	if (Health != NewHealth)
+	{
+		Health = NewHealth;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATopDownCharacter, Health, this);
+		PushDirtyMask |= 1 << 0;
+		INC_DWORD_STAT(STAT_TopDownPushModelDirtyMarks);
+	}
+}
+
+void ATopDownCharacter::SetIsDead(bool bNewIsDead)
+{
+	if (bIsDead != bNewIsDead)
+	{
+		bIsDead = bNewIsDead;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATopDownCharacter, bIsDead, this);
+		PushDirtyMask |= 1 << 1;
+		INC_DWORD_STAT(STAT_TopDownPushModelDirtyMarks);
+	}
+}
+
+void ATopDownCharacter::SetIsPooled(bool bNewIsPooled)
+{
+	if (bIsPooled != bNewIsPooled)
+	{
+		bIsPooled = bNewIsPooled;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATopDownCharacter, bIsPooled, this);
+		PushDirtyMask |= 1 << 3;
+		INC_DWORD_STAT(STAT_TopDownPushModelDirtyMarks);
+	}
 }
 
 void ATopDownCharacter::BeginPlay()
@@ -122,10 +245,25 @@ void ATopDownCharacter::BeginPlay()
 		}
 	}
 
+	// Possession may have happened before the tick function was registered
+	UpdateTickEnabled();
+
+	// Track position for proximity queries
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->RegisterActor(this, ESpatialGridCategory::Character);
+	}
+
 	// Log character initialization
 	if (HasAuthority())
 	{
 		UE_LOG(LogTemp, Log, TEXT("TopDownCharacter spawned on server: %s"), *GetName());
+
+		// Record transform history so shots can be lag compensated against us
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
 	}
 	else
 	{
@@ -135,17 +273,57 @@ void ATopDownCharacter::BeginPlay()
 	// HUD is now managed by PlayerController (persists across respawns)
 }
 
+void ATopDownCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld() ? GetWorld()->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+	{
+		SpatialGrid->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATopDownCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Update character rotation toward mouse cursor (client-side only)
-	if (IsLocallyControlled() && TopDownCameraComponent)
+	INC_DWORD_STAT(STAT_TopDownCharacterTicks);
+
+	// Update character rotation toward mouse cursor (local player only; bots aim through their controller)
+	if (IsLocallyControlled() && IsPlayerControlled() && TopDownCameraComponent)
 	{
 		UpdateRotationToMouseCursor(DeltaTime);
 	}
 }
 
+void ATopDownCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	UpdateTickEnabled();
+
+	// A pooled character keeps the input disabled by its previous death; its new owner needs it back
+	if (IsLocallyControlled())
+	{
+		EnableInput(Cast<APlayerController>(Controller));
+	}
+}
+
+void ATopDownCharacter::UpdateTickEnabled()
+{
+	// Server, bots (locally controlled on the server too) and simulated proxies have nothing to do
+	// per frame unless a Blueprint subclass ticks
+	static const FName ReceiveTickName = GET_FUNCTION_NAME_CHECKED(AActor, ReceiveTick);
+	const bool bHasBlueprintTick = GetClass()->IsFunctionImplementedInScript(ReceiveTickName);
+
+	SetActorTickEnabled((IsLocallyControlled() && IsPlayerControlled()) || bHasBlueprintTick);
+}
+
 void ATopDownCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -216,28 +394,19 @@ void ATopDownCharacter::OnFirePressed()
 {
 	bIsFirePressed = true;
 
-	// Request fire immediately (server will check CanFire)
+	// Server starts firing and keeps the cadence while the trigger is held
 	if (WeaponComponent)
 	{
-		// Calculate fire direction (where character is facing) and normalize
-		FVector FireDirection = GetActorRotation().Vector();
-		FireDirection.Normalize(); // Ensure normalized for network transmission
-		ServerRequestFire(FireDirection);
-	}
+		const float PressTime = WeaponComponent->GetWorldTime();
+		ServerSetTriggerState(true, FRotator::CompressAxisToShort(GetActorRotation().Yaw), WeaponComponent->GetNextShotKey(), PressTime);
 
-	// Start automatic firing timer
-	if (GetWorld())
-	{
-		// Calculate fire interval from WeaponComponent's fire rate
-		float FireInterval = WeaponComponent ? (60.0f / FMath::Max(1.0f, WeaponComponent->FireRate)) : 0.1f;
-		
-		GetWorld()->GetTimerManager().SetTimer(
-			AutoFireTimerHandle,
-			this,
-			&ATopDownCharacter::HandleAutoFire,
-			FireInterval,
-			true  // Loop
-		);
+		// Owning client runs the same cadence locally for zero-latency feedback
+		if (WeaponComponent->IsPredictingLocally())
+		{
+			TriggerShotTime = PressTime;
+			HandleAutoFire();
+			StartAutoFire();
+		}
 	}
 }
 
@@ -245,69 +414,217 @@ void ATopDownCharacter::OnFireReleased()
 {
 	bIsFirePressed = false;
 
-	// Stop automatic firing
-	if (GetWorld())
+	if (WeaponComponent)
 	{
-		GetWorld()->GetTimerManager().ClearTimer(AutoFireTimerHandle);
+		ServerSetTriggerState(false, FRotator::CompressAxisToShort(GetActorRotation().Yaw), WeaponComponent->GetNextShotKey(), WeaponComponent->GetWorldTime());
+
+		if (WeaponComponent->IsPredictingLocally())
+		{
+			StopAutoFire();
+		}
+	}
+}
+
+void ATopDownCharacter::BotMove(const FVector2D& MoveVector)
+{
+	Move(FInputActionValue(MoveVector));
+}
+
+void ATopDownCharacter::BotSetTrigger(bool bPressed)
+{
+	if (bPressed)
+	{
+		OnFirePressed();
+	}
+	else
+	{
+		OnFireReleased();
 	}
 }
 
+void ATopDownCharacter::BotReload()
+{
+	Reload();
+}
+
+namespace TopDownCharacter
+{
+	/** Cap on catch-up shots in one fire update (after a hitch, the rest of the backlog is dropped) */
+	constexpr int32 MaxShotsPerFireUpdate = 8;
+}
+
 void ATopDownCharacter::HandleAutoFire()
 {
-	// Only continue firing if button is still pressed
-	if (!bIsFirePressed)
+	// Only continue firing while the trigger is held and we're alive
+	if (!bIsFirePressed || bIsDead || !WeaponComponent)
 	{
-		if (GetWorld())
+		StopAutoFire();
+		return;
+	}
+
+	// The server runs the burst as far behind as the client's press reached it, so by the time
+	// the release arrives it has not fired past the client's release time
+	const float Now = WeaponComponent->GetWorldTime();
+	FireDueShots(HasAuthority() ? Now - TriggerFireDelay : Now);
+}
+
+void ATopDownCharacter::FireDueShots(float UntilTime, int32 StopAtShotKey)
+{
+	// Each due shot keeps its own time within the frame; the weapon checks ammo and cooldown
+	// against it and handles auto-reload
+	for (int32 Shot = 0; Shot < TopDownCharacter::MaxShotsPerFireUpdate; ++Shot)
+	{
+		const float ShotTime = FMath::Max(TriggerShotTime, WeaponComponent->GetNextFireTime());
+		if (ShotTime > UntilTime)
+		{
+			break;
+		}
+
+		if (StopAtShotKey != INDEX_NONE && WeaponComponent->GetNextShotKey() == StopAtShotKey)
+		{
+			break;
+		}
+
+		const bool bFired = HasAuthority() ? FireWeapon(ShotTime) : PredictFireWeapon(ShotTime);
+		if (!bFired)
 		{
-			GetWorld()->GetTimerManager().ClearTimer(AutoFireTimerHandle);
+			break;
 		}
+	}
+
+	// Time spent unable to fire (empty, reloading) is not owed afterwards
+	TriggerShotTime = FMath::Max(TriggerShotTime, UntilTime);
+}
+
+void ATopDownCharacter::StartAutoFire()
+{
+	if (!GetWorld() || !WeaponComponent)
+	{
 		return;
 	}
 
-	// Request fire (server will check CanFire and handle auto-reload)
-	if (WeaponComponent)
+	// Schedule the following shots against the weapon's cooldown (server: behind by the press delay)
+	const float FireInterval = WeaponComponent->GetFireCooldown();
+	const float FirstDelay = WeaponComponent->GetFireCooldownRemaining() + TriggerFireDelay;
+
+	GetWorld()->GetTimerManager().SetTimer(
+		AutoFireTimerHandle,
+		this,
+		&ATopDownCharacter::HandleAutoFire,
+		FireInterval,
+		true,  // Loop
+		FirstDelay > 0.0f ? FirstDelay : FireInterval
+	);
+}
+
+void ATopDownCharacter::StopAutoFire()
+{
+	if (GetWorld())
 	{
-		// Calculate fire direction (where character is facing) and normalize
-		FVector FireDirection = GetActorRotation().Vector();
-		FireDirection.Normalize(); // Ensure normalized for network transmission
-		ServerRequestFire(FireDirection);
+		GetWorld()->GetTimerManager().ClearTimer(AutoFireTimerHandle);
 	}
 }
 
 void ATopDownCharacter::Reload()
 {
-	// Client-side input - request reload from server
+	// Client-side input - request reload from server (and show it starting right away)
 	if (WeaponComponent && WeaponComponent->CanReload())
 	{
+		WeaponComponent->PredictReload();
 		ServerRequestReload();
 	}
 }
 
-void ATopDownCharacter::ServerRequestFire_Implementation(FVector_NetQuantize10 FireDirection)
+void ATopDownCharacter::ServerSetTriggerState_Implementation(bool bPressed, uint16 AimYaw, uint8 ShotKey, float ClientFireTime)
 {
+	TOPDOWN_INC_COUNTER(RPCsReceived, 1);
+
+	const bool bWasFirePressed = bIsFirePressed;
+	bIsFirePressed = bPressed;
+
+	if (!bPressed || !WeaponComponent || bIsDead)
+	{
+		// Fire the shots the client fired before releasing that are still owed, but none scheduled
+		// after its release time and none past its last predicted key
+		if (!bPressed && bWasFirePressed && WeaponComponent && !bIsDead)
+		{
+			FireDueShots(WeaponComponent->ClampClientFireTime(ClientFireTime), ShotKey);
+		}
+
+		StopAutoFire();
+		return;
+	}
+
+	// Aim at the yaw the client pressed the trigger with (rotation updates are unreliable)
+	if (!IsLocallyControlled())
+	{
+		SetActorRotation(FRotator(0.0f, FRotator::DecompressAxisFromShort(AimYaw), 0.0f));
+	}
+
+	// This burst's shots acknowledge the client's predictions key for key
+	WeaponComponent->SetNextShotKey(ShotKey);
+
+	// Schedule from when the client pressed, not when the RPC was processed
+	// (the weapon still rejects the first shot if on cooldown from a previous burst)
+	TriggerShotTime = WeaponComponent->ClampClientFireTime(ClientFireTime);
+	TriggerFireDelay = IsLocallyControlled() ? 0.0f : WeaponComponent->GetWorldTime() - TriggerShotTime;
+	HandleAutoFire();
+
+	StartAutoFire();
+}
+
+bool ATopDownCharacter::ServerSetTriggerState_Validate(bool bPressed, uint16 AimYaw, uint8 ShotKey, float ClientFireTime)
+{
+	// Any compressed yaw is valid
+	return true;
+}
+
+bool ATopDownCharacter::FireWeapon(float ShotTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(FireWeapon);
+
+	// Calculate fire direction (where character is facing)
+	const FVector FireDirection = GetActorRotation().Vector().GetSafeNormal();
+
 	// Server-side fire logic
-	if (WeaponComponent && WeaponComponent->TryFire(FireDirection))
+	if (WeaponComponent && WeaponComponent->TryFire(FireDirection, ShotTime))
 	{
-		UE_LOG(LogTemp, Log, TEXT("Server: %s fired weapon in direction %s"), *GetName(), *FireDirection.ToString());
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Server: %s fired weapon in direction %s"), *GetName(), *FireDirection.ToString());
 		
 		// Calculate muzzle location for effects
 		FRotator FireRotation = FireDirection.Rotation();
 		FVector MuzzleLocation = GetActorLocation() + FireRotation.RotateVector(WeaponComponent->MuzzleOffset);
+		FCombatJournal::Get().Record(ECombatJournalEvent::Fire, this, nullptr, MuzzleLocation);
 		
-		// Play fire effects on all clients (including server)
-		MulticastPlayFireEffects(MuzzleLocation, FireDirection);
+		// Play fire effects on nearby clients (including a listen server host; a predicting owner already has)
+		if (UCosmeticEventSubsystem* CosmeticEvents = GetWorld()->GetSubsystem<UCosmeticEventSubsystem>())
+		{
+			CosmeticEvents->QueueEvent(ECosmeticEventType::Muzzle, GetClass(), MuzzleLocation, FireDirection,
+			                           WeaponComponent->bClientPrediction ? this : nullptr);
+		}
+		return true;
 	}
+	return false;
 }
 
-bool ATopDownCharacter::ServerRequestFire_Validate(FVector_NetQuantize10 FireDirection)
+bool ATopDownCharacter::PredictFireWeapon(float ShotTime)
 {
-	// Basic validation - just check it's not zero
-	// (Network quantization may affect precision, so we're lenient)
-	return !FireDirection.IsNearlyZero(0.01f);
+	const FVector FireDirection = GetActorRotation().Vector().GetSafeNormal();
+
+	if (WeaponComponent && WeaponComponent->PredictFire(FireDirection, ShotTime))
+	{
+		// Muzzle flash now instead of a round trip later
+		const FVector MuzzleLocation = GetActorLocation() + FireDirection.Rotation().RotateVector(WeaponComponent->MuzzleOffset);
+		PlayFireEffects(GetWorld(), MuzzleLocation, FireDirection);
+		return true;
+	}
+	return false;
 }
 
 void ATopDownCharacter::ServerRequestReload_Implementation()
 {
+	TOPDOWN_INC_COUNTER(RPCsReceived, 1);
+
 	// Server-side reload logic
 	if (WeaponComponent && WeaponComponent->StartReload())
 	{
@@ -322,19 +639,14 @@ bool ATopDownCharacter::ServerRequestReload_Validate()
 	return true;
 }
 
-void ATopDownCharacter::ServerUpdateRotation_Implementation(FRotator NewRotation)
-{
-	// Server updates rotation for replication to all clients
-	SetActorRotation(NewRotation);
-}
-
-void ATopDownCharacter::MulticastPlayFireEffects_Implementation(FVector_NetQuantize MuzzleLocation, FVector_NetQuantize FireDirection)
+void ATopDownCharacter::PlayFireEffects(UWorld* World, const FVector& MuzzleLocation, const FVector& FireDirection) const
 {
+#if !UE_SERVER
 	// Play muzzle flash particle effect
 	if (MuzzleFlash)
 	{
 		UGameplayStatics::SpawnEmitterAtLocation(
-			GetWorld(),
+			World,
 			MuzzleFlash,
 			MuzzleLocation,
 			FireDirection.Rotation(),
@@ -347,13 +659,14 @@ void ATopDownCharacter::MulticastPlayFireEffects_Implementation(FVector_NetQuant
 	if (FireSound)
 	{
 		UGameplayStatics::PlaySoundAtLocation(
-			this,
+			World,
 			FireSound,
 			MuzzleLocation
 		);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Playing fire effects at %s"), *MuzzleLocation.ToString());
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Playing fire effects at %s"), *MuzzleLocation.ToString());
+#endif
 }
 
 void ATopDownCharacter::UpdateRotationToMouseCursor(float DeltaTime)
@@ -402,13 +715,8 @@ void ATopDownCharacter::UpdateRotationToMouseCursor(float DeltaTime)
 
 						// Apply rotation (Yaw only for top-down)
 						FRotator FinalRotation = FRotator(0.0f, NewRotation.Yaw, 0.0f);
+						// The yaw reaches the server inside the next saved move (UTopDownMovementComponent)
 						SetActorRotation(FinalRotation);
-
-						// Send rotation to server for replication
-						if (!HasAuthority())
-						{
-							ServerUpdateRotation(FinalRotation);
-						}
 					}
 				}
 			}
@@ -423,6 +731,9 @@ void ATopDownCharacter::UpdateRotationToMouseCursor(float DeltaTime)
 float ATopDownCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, 
                                      AController* EventInstigator, AActor* DamageCauser)
 {
+	TOPDOWN_SCOPE_CYCLE_COUNTER(TakeDamage);
+	TOPDOWN_INC_COUNTER(DamageEvents, 1);
+
 	// Only process damage on server
 	if (!HasAuthority())
 	{
@@ -440,26 +751,54 @@ float ATopDownCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Dama
 
 	if (ActualDamage > 0.0f)
 	{
-		// Reduce health
-		Health = FMath::Max(0.0f, Health - ActualDamage);
+		FCombatJournal::Get().Record(ECombatJournalEvent::Damage, EventInstigator, this, GetActorLocation(), ActualDamage);
+		ApplyHealthLoss(ActualDamage, EventInstigator);
+	}
 
-		UE_LOG(LogTemp, Log, TEXT("%s took %.2f damage, health now: %.2f/%.2f"), 
-		       *GetName(), ActualDamage, Health, MaxHealth);
+	return ActualDamage;
+}
 
-		// Update HUD (server doesn't trigger OnRep, so update manually)
-		if (IsLocallyControlled())
+float ATopDownCharacter::TakeDamageBatch(TConstArrayView<FDamageContribution> Contributions)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(TakeDamage);
+	TOPDOWN_INC_COUNTER(DamageEvents, Contributions.Num());
+
+	if (!HasAuthority() || bIsDead)
+	{
+		return 0.0f;
+	}
+
+	float TotalDamage = 0.0f;
+	bool bLethal = false;
+	AController* Killer = nullptr;
+
+	for (const FDamageContribution& Contribution : Contributions)
+	{
+		// Engine pipeline per hit (damage modifiers, OnTakeAnyDamage), health change once below
+		AController* EventInstigator = Contribution.Instigator.Get();
+		const float ActualDamage = Super::TakeDamage(Contribution.Damage, FDamageEvent(Contribution.DamageTypeClass), EventInstigator, Contribution.Causer.Get());
+		if (ActualDamage <= 0.0f)
 		{
-			UpdateHUDDisplay();
+			continue;
 		}
 
-		// Check if character died
-		if (Health <= 0.0f && !bIsDead)
+		FCombatJournal::Get().Record(ECombatJournalEvent::Damage, EventInstigator, this, GetActorLocation(), ActualDamage);
+		TotalDamage += ActualDamage;
+
+		// Kill credit goes to the hit that crossed zero, not the last one in the batch
+		if (!bLethal && TotalDamage >= Health)
 		{
-			Die(EventInstigator);
+			bLethal = true;
+			Killer = EventInstigator;
 		}
 	}
 
-	return ActualDamage;
+	if (TotalDamage > 0.0f)
+	{
+		ApplyHealthLoss(TotalDamage, Killer);
+	}
+
+	return TotalDamage;
 }
 
 void ATopDownCharacter::Die(AController* Killer)
@@ -471,9 +810,12 @@ void ATopDownCharacter::Die(AController* Killer)
 	}
 
 	// Mark as dead
-	bIsDead = true;
+	SetIsDead(true);
+	bIsFirePressed = false;
+	StopAutoFire();
 
 	UE_LOG(LogTemp, Log, TEXT("%s has died"), *GetName());
+	FCombatJournal::Get().Record(ECombatJournalEvent::Death, Killer, this, GetActorLocation());
 
 	// Call multicast to handle death on all clients (including server)
 	MulticastHandleDeath();
@@ -485,16 +827,44 @@ void ATopDownCharacter::Die(AController* Killer)
 	}
 }
 
+void ATopDownCharacter::ApplyHealthLoss(float TotalDamage, AController* Killer)
+{
+	// Reduce health
+	SetHealth(FMath::Max(0.0f, Health - TotalDamage));
+
+	TOPDOWN_COMBAT_LOG(Log, TEXT("%s took %.2f damage, health now: %.2f/%.2f"),
+	                   *GetName(), TotalDamage, Health, MaxHealth);
+
+	// Update HUD (server doesn't trigger OnRep, so update manually)
+	if (IsLocallyControlled())
+	{
+		UpdateHUDDisplay(EHUDDirtyFlags::Health);
+	}
+
+	// Check if character died
+	if (Health <= 0.0f && !bIsDead)
+	{
+		Die(Killer);
+	}
+}
+
 void ATopDownCharacter::MulticastHandleDeath_Implementation()
 {
 	UE_LOG(LogTemp, Log, TEXT("MulticastHandleDeath: %s"), *GetName());
 
 	// Ensure health is 0 on all clients for UI display
-	Health = 0.0f;
-	bIsDead = true;
+	SetHealth(0.0f);
+	SetIsDead(true);
 
 	// Update HUD to show 0 health
-	UpdateHUDDisplay();
+	UpdateHUDDisplay(EHUDDirtyFlags::Health);
+
+	// Shots predicted after the server's fatal hit never happened
+	if (WeaponComponent)
+	{
+		StopAutoFire();
+		WeaponComponent->ClearPrediction();
+	}
 
 	// Disable input (on owning client)
 	if (IsLocallyControlled())
@@ -519,10 +889,10 @@ void ATopDownCharacter::MulticastHandleDeath_Implementation()
 void ATopDownCharacter::OnRep_Health(float OldHealth)
 {
 	// Called on clients when health changes
-	UE_LOG(LogTemp, Log, TEXT("Client: Health changed from %.2f to %.2f"), OldHealth, Health);
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Client: Health changed from %.2f to %.2f"), OldHealth, Health);
 
 	// Update HUD
-	UpdateHUDDisplay();
+	UpdateHUDDisplay(EHUDDirtyFlags::Health);
 
 	// TODO: Play damage effects in future tasks
 
@@ -534,11 +904,17 @@ void ATopDownCharacter::OnRep_Health(float OldHealth)
 	}
 }
 
+void ATopDownCharacter::OnRep_PlanarMovement()
+{
+	PlanarMovement.ToRepMovement(GetReplicatedMovement_Mutable());
+	OnRep_ReplicatedMovement();
+}
+
 void ATopDownCharacter::ResetForRespawn()
 {
 	// Reset health
-	Health = MaxHealth;
-	bIsDead = false;
+	SetHealth(MaxHealth);
+	SetIsDead(false);
 
 	// Reset weapon component ammo
 	if (WeaponComponent)
@@ -548,10 +924,7 @@ void ATopDownCharacter::ResetForRespawn()
 
 	// Re-enable collision
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	GetMesh()->SetSimulatePhysics(false);
-	GetMesh()->SetCollisionProfileName(TEXT("CharacterMesh"));
-	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	RestoreMeshFromRagdoll();
 
 	// Re-enable input
 	if (IsLocallyControlled())
@@ -565,10 +938,106 @@ void ATopDownCharacter::ResetForRespawn()
 	UE_LOG(LogTemp, Log, TEXT("%s respawned with full health and ammo"), *GetName());
 
 	// Update HUD after respawn
-	UpdateHUDDisplay();
+	UpdateHUDDisplay(EHUDDirtyFlags::All);
+}
+
+void ATopDownCharacter::RestoreMeshFromRagdoll()
+{
+	USkeletalMeshComponent* MeshComponent = GetMesh();
+	MeshComponent->SetSimulatePhysics(false);
+	MeshComponent->SetCollisionProfileName(TEXT("CharacterMesh"));
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	MeshComponent->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	MeshComponent->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+}
+
+// ========================================================================================
+// Pooling
+// ========================================================================================
+
+void ATopDownCharacter::DeactivateToPool()
+{
+	if (!HasAuthority())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeactivateToPool called on client - should only be called on server"));
+		return;
+	}
+
+	SetIsPooled(true);
+	ApplyPooledState();
+
+	// Nothing about a parked character changes; the final state is flushed before the channel goes dormant
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void ATopDownCharacter::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	if (!HasAuthority())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ActivateFromPool called on client - should only be called on server"));
+		return;
+	}
+
+	SetNetDormancy(DORM_Awake);
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	SetIsPooled(false);
+	ApplyPooledState();
+}
+
+void ATopDownCharacter::OnRep_IsPooled()
+{
+	ApplyPooledState();
+}
+
+void ATopDownCharacter::ApplyPooledState()
+{
+	SetActorHiddenInGame(bIsPooled);
+
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>();
+	ULagCompensationSubsystem* LagCompensation = HasAuthority() ? GetWorld()->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+
+	if (bIsPooled)
+	{
+		// Undo the ragdoll now so the mesh is ready when the character is reused
+		RestoreMeshFromRagdoll();
+		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+		Movement->StopMovementImmediately();
+		Movement->DisableMovement();
+		Movement->SetComponentTickEnabled(false);
+
+		// Parked characters are not spawn threats or hitscan targets
+		if (SpatialGrid)
+		{
+			SpatialGrid->UnregisterActor(this);
+		}
+		if (LagCompensation)
+		{
+			LagCompensation->UnregisterCharacter(this);
+		}
+	}
+	else
+	{
+		RestoreMeshFromRagdoll();
+		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+		Movement->SetComponentTickEnabled(true);
+		Movement->SetMovementMode(MOVE_Walking);
+
+		if (SpatialGrid)
+		{
+			SpatialGrid->RegisterActor(this, ESpatialGridCategory::Character);
+		}
+		if (LagCompensation)
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+	}
 }
 
-void ATopDownCharacter::UpdateHUDDisplay()
+void ATopDownCharacter::UpdateHUDDisplay(EHUDDirtyFlags Fields)
 {
 	if (IsLocallyControlled())
 	{
@@ -576,7 +1045,7 @@ void ATopDownCharacter::UpdateHUDDisplay()
 		{
 			if (PC->HUDWidget)
 			{
-				PC->HUDWidget->UpdateHUD();
+				PC->HUDWidget->MarkDirty(Fields);
 			}
 		}
 	}
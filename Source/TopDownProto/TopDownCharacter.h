@@ -5,9 +5,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "TopDownMovementComponent.h"
 #include "TopDownCharacter.generated.h"
 
 class UWeaponComponent;
+struct FDamageContribution;
+enum class EHUDDirtyFlags : uint8;
 
 /**
  * ATopDownCharacter
@@ -21,16 +24,19 @@ class TOPDOWNPROTO_API ATopDownCharacter : public ACharacter
 	GENERATED_BODY()
 
 public:
-	ATopDownCharacter();
+	ATopDownCharacter(const FObjectInitializer& ObjectInitializer);
 
 	//~ Begin AActor Interface
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	//~ End AActor Interface
 
 	//~ Begin APawn Interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	virtual void NotifyControllerChanged() override;
 	//~ End APawn Interface
 
 	//~ Begin AActor Interface
@@ -38,6 +44,15 @@ public:
 	                         class AController* EventInstigator, AActor* DamageCauser) override;
 	//~ End AActor Interface
 
+	/**
+	 * Take a frame's worth of hits at once (server only, see UDamageAggregationSubsystem)
+	 * Each hit still goes through the engine damage pipeline, but health, the HUD and the
+	 * death check are updated once; the hit that took health to zero gets the kill
+	 * @param Contributions - Hits in arrival order
+	 * @return Total damage taken
+	 */
+	float TakeDamageBatch(TConstArrayView<FDamageContribution> Contributions);
+
 	/** Returns TopDownCameraComponent subobject */
 	FORCEINLINE class UCameraComponent* GetTopDownCameraComponent() const { return TopDownCameraComponent; }
 	
@@ -63,8 +78,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void ResetForRespawn();
 
-	/** Update HUD display */
-	void UpdateHUDDisplay();
+	/**
+	 * Flag HUD fields for the end-of-frame redraw (local player only)
+	 * @param Fields - Fields that may have changed
+	 */
+	void UpdateHUDDisplay(EHUDDirtyFlags Fields);
+
+	/**
+	 * Spawn muzzle flash and fire sound locally (callable on the class default object, no-op in server builds)
+	 * @param World - World to play the effects in
+	 * @param MuzzleLocation - Muzzle location
+	 * @param FireDirection - Fire direction
+	 */
+	void PlayFireEffects(UWorld* World, const FVector& MuzzleLocation, const FVector& FireDirection) const;
+
+	// ========================================================================================
+	// AI Input (ATopDownBotController)
+	// ========================================================================================
+
+	/** Feed a screen-space move vector through the Move input handler */
+	void BotMove(const FVector2D& MoveVector);
+
+	/** Press or release the trigger through the fire input handlers */
+	void BotSetTrigger(bool bPressed);
+
+	/** Request a reload through the reload input handler */
+	void BotReload();
 
 protected:
 	/** Called for movement input */
@@ -82,11 +121,22 @@ protected:
 	/** Called for reload input */
 	void Reload();
 
-	/** Server RPC - Request to fire weapon with direction */
+	/**
+	 * Server RPC - Trigger pressed or released
+	 * The server runs the fire cadence itself while the trigger is held, so this is sent
+	 * once per press/release instead of once per shot
+	 * @param bPressed - New trigger state
+	 * @param AimYaw - Facing yaw at the time of the change (FRotator::CompressAxisToShort)
+	 * @param ShotKey - Press: prediction key of the client's first shot of the burst (see UWeaponComponent::PredictFire);
+	 *                  release: the client's next key, so the server fires no shot the client did not predict
+	 * @param ClientFireTime - Client's estimate of server time at the change; on press the burst is scheduled
+	 *                         from it, on release no shot scheduled after it is fired
+	 *                         (clamped by UWeaponComponent::ClampClientFireTime)
+	 */
 	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerRequestFire(FVector_NetQuantize10 FireDirection);
-	void ServerRequestFire_Implementation(FVector_NetQuantize10 FireDirection);
-	bool ServerRequestFire_Validate(FVector_NetQuantize10 FireDirection);
+	void ServerSetTriggerState(bool bPressed, uint16 AimYaw, uint8 ShotKey, float ClientFireTime);
+	void ServerSetTriggerState_Implementation(bool bPressed, uint16 AimYaw, uint8 ShotKey, float ClientFireTime);
+	bool ServerSetTriggerState_Validate(bool bPressed, uint16 AimYaw, uint8 ShotKey, float ClientFireTime);
 
 	/** Server RPC - Request to reload weapon */
 	UFUNCTION(Server, Reliable, WithValidation)
@@ -94,16 +144,6 @@ protected:
 	void ServerRequestReload_Implementation();
 	bool ServerRequestReload_Validate();
 
-	/** Multicast RPC - Play fire effects on all clients */
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastPlayFireEffects(FVector_NetQuantize MuzzleLocation, FVector_NetQuantize FireDirection);
-	void MulticastPlayFireEffects_Implementation(FVector_NetQuantize MuzzleLocation, FVector_NetQuantize FireDirection);
-
-	/** Server RPC - Update character rotation */
-	UFUNCTION(Server, Unreliable)
-	void ServerUpdateRotation(FRotator NewRotation);
-	void ServerUpdateRotation_Implementation(FRotator NewRotation);
-
 	// ========================================================================================
 	// Health System
 	// ========================================================================================
@@ -111,6 +151,13 @@ protected:
 	/** Called when character dies (server only) */
 	virtual void Die(AController* Killer);
 
+	/**
+	 * Subtract damage already accepted by the damage pipeline and handle death (server only)
+	 * @param TotalDamage - Damage to subtract from health
+	 * @param Killer - Controller credited if this kills the character
+	 */
+	void ApplyHealthLoss(float TotalDamage, AController* Killer);
+
 	/** Multicast RPC - Play death effects on all clients */
 	UFUNCTION(NetMulticast, Reliable)
 	void MulticastHandleDeath();
@@ -120,6 +167,28 @@ protected:
 	UFUNCTION()
 	void OnRep_Health(float OldHealth);
 
+	/** Called on simulated proxies when planar movement arrives; feeds the stock ReplicatedMovement path */
+	UFUNCTION()
+	void OnRep_PlanarMovement();
+
+	// ========================================================================================
+	// Pooling (UCharacterPoolSubsystem)
+	// ========================================================================================
+
+	/** Park this dead character: hidden, no collision or movement, net dormant (server only) */
+	void DeactivateToPool();
+
+	/** Take this character out of the pool at a new location; ResetForRespawn restores gameplay state (server only) */
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
+	/** Is this character parked in the pool? */
+	UFUNCTION(BlueprintPure, Category = "Pooling")
+	bool IsPooled() const { return bIsPooled; }
+
+	/** Called on clients when the character enters or leaves the pool */
+	UFUNCTION()
+	void OnRep_IsPooled();
+
 protected:
 	/** Top down camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -185,19 +254,92 @@ protected:
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Health", meta = (AllowPrivateAccess = "true"))
 	bool bIsDead;
 
+	// ========================================================================================
+	// Movement Replication
+	// ========================================================================================
+
+	/** Parked in UCharacterPoolSubsystem (replicated so clients hide it and undo the ragdoll) */
+	UPROPERTY(ReplicatedUsing = OnRep_IsPooled)
+	bool bIsPooled;
+
+	/** Simulated-proxy movement, replicated instead of AActor::ReplicatedMovement */
+	UPROPERTY(ReplicatedUsing = OnRep_PlanarMovement)
+	FTopDownRepMovement PlanarMovement;
+
+	// ========================================================================================
+	// Push Model Setters (all writes to replicated health state go through these)
+	// ========================================================================================
+
+	/** Set health and mark it dirty for replication */
+	void SetHealth(float NewHealth);
+
+	/** Set dead flag and mark it dirty for replication */
+	void SetIsDead(bool bNewIsDead);
+
+	/** Set pooled flag and mark it dirty for replication */
+	void SetIsPooled(bool bNewIsPooled);
+
 private:
 	/** Initialize character components and settings */
 	void InitializeCharacter();
 
+	/** Apply bIsPooled locally: visibility, collision, movement and query registration */
+	void ApplyPooledState();
+
+	/** Stop ragdoll simulation and put the mesh back on the capsule at its default offset */
+	void RestoreMeshFromRagdoll();
+
+	/** Enable actor tick only where Tick() has work (the locally controlled player character) */
+	void UpdateTickEnabled();
+
 	/** Update character rotation to face mouse cursor position */
 	void UpdateRotationToMouseCursor(float DeltaTime);
 
-	/** Handle automatic firing while fire button is held */
+	/**
+	 * Fire one shot in the current facing direction (server only)
+	 * @param ShotTime - Server time the shot is scheduled for (< 0 = now)
+	 * @return True if the weapon fired
+	 */
+	bool FireWeapon(float ShotTime = -1.0f);
+
+	/**
+	 * Predict one shot in the current facing direction and play its effects now (owning client)
+	 * @param ShotTime - Estimated server time the shot is scheduled for
+	 * @return True if the shot was predicted
+	 */
+	bool PredictFireWeapon(float ShotTime);
+
+	/**
+	 * Fire every shot of the held trigger that is due by now, each at its scheduled time
+	 * (server fires, owning client predicts), so shots are never lost to frame quantization
+	 */
 	void HandleAutoFire();
 
-	/** Timer handle for automatic firing */
+	/**
+	 * Fire (server) or predict (owning client) the held trigger's shots scheduled up to a time
+	 * @param UntilTime - No shot scheduled after this is fired
+	 * @param StopAtShotKey - Server: stop before the shot that would get this prediction key, or INDEX_NONE
+	 */
+	void FireDueShots(float UntilTime, int32 StopAtShotKey = INDEX_NONE);
+
+	/** Start the auto-fire loop against the weapon's cooldown */
+	void StartAutoFire();
+
+	/** Stop the auto-fire loop */
+	void StopAutoFire();
+
+	/** Timer handle for automatic firing (server, and the owning client when predicting) */
 	FTimerHandle AutoFireTimerHandle;
 
-	/** Is fire button currently pressed? */
+	/** Is fire button currently pressed? (server: last trigger state received from the owning client) */
 	bool bIsFirePressed;
+
+	/** Earliest server time the next shot of the held trigger may be scheduled at (press time, then last catch-up) */
+	float TriggerShotTime;
+
+	/** Server: how long after the client's press the trigger RPC arrived; the burst's cadence runs this far behind */
+	float TriggerFireDelay;
+
+	/** Push-model properties marked dirty since the last PreReplication (for STAT_TopDownPushModelComparesSkipped) */
+	uint8 PushDirtyMask;
 };
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownCombatLog.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogTopDownCombat);
+
+static TAutoConsoleVariable<float> CVarTopDownLogRateLimitInterval(
+	TEXT("TopDown.Log.RateLimitInterval"),
+	1.0f,
+	TEXT("Minimum seconds between two lines from the same TOPDOWN_COMBAT_LOG callsite (0 = no limit)"),
+	ECVF_Default
+);
+
+// ========================================================================================
+// Rate Limiter
+// ========================================================================================
+
+bool FTopDownLogRateLimiter::TryLog(int32& OutNumSuppressed)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextLogTime)
+	{
+		++NumSuppressed;
+		return false;
+	}
+
+	NextLogTime = Now + CVarTopDownLogRateLimitInterval.GetValueOnGameThread();
+	OutNumSuppressed = NumSuppressed;
+	NumSuppressed = 0;
+	return true;
+}
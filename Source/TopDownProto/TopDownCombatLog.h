@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * LogTopDownCombat
+ *
+ * Per-shot combat text logging (fire, spawn, hit, damage, projectile release).
+ * The durable record of fights is the binary FCombatJournal; these lines are for debugging.
+ * The category defaults to Warning, so Log lines stay off unless enabled with "Log LogTopDownCombat Log";
+ * shipping builds compile everything below Warning out, arguments included. That matters most for
+ * TopDownProtoServer, which keeps logging in shipping (bUseLoggingInShipping) for warnings and errors.
+ */
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogTopDownCombat, Warning, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogTopDownCombat, Warning, All);
+#endif
+
+/**
+ * FTopDownLogRateLimiter
+ *
+ * Per-callsite limiter for TOPDOWN_COMBAT_LOG: at most one line per
+ * TopDown.Log.RateLimitInterval seconds, appending how many were dropped in between (when any were).
+ */
+struct TOPDOWNPROTO_API FTopDownLogRateLimiter
+{
+	/**
+	 * May this callsite log now?
+	 * @param OutNumSuppressed - Lines dropped since the last one that was let through
+	 */
+	bool TryLog(int32& OutNumSuppressed);
+
+private:
+	double NextLogTime = 0.0;
+	int32 NumSuppressed = 0;
+};
+
+/**
+ * Rate-limited LogTopDownCombat line
+ * Arguments are only evaluated when the verbosity is active, and not at all in shipping.
+ * Game thread only (the limiter is a function-local static).
+ */
+#define TOPDOWN_COMBAT_LOG(Verbosity, Format, ...) \
+	do \
+	{ \
+		if (UE_LOG_ACTIVE(LogTopDownCombat, Verbosity)) \
+		{ \
+			static FTopDownLogRateLimiter TopDownLogLimiter; \
+			int32 TopDownLogNumSuppressed = 0; \
+			if (TopDownLogLimiter.TryLog(TopDownLogNumSuppressed)) \
+			{ \
+				if (TopDownLogNumSuppressed > 0) \
+				{ \
+					UE_LOG(LogTopDownCombat, Verbosity, Format TEXT(" (+%d suppressed)"), ##__VA_ARGS__, TopDownLogNumSuppressed); \
+				} \
+				else \
+				{ \
+					UE_LOG(LogTopDownCombat, Verbosity, Format, ##__VA_ARGS__); \
+				} \
+			} \
+		} \
+	} \
+	while (0)
@@ -4,14 +4,52 @@
 #include "TopDownGameState.h"
 #include "TopDownCharacter.h"
 #include "TopDownPlayerController.h"
+#include "SpatialGridSubsystem.h"
+#include "CharacterPoolSubsystem.h"
+#include "TopDownBotController.h"
+#include "LoadTestSubsystem.h"
+#include "TopDownStats.h"
+#include "CombatJournal.h"
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
 #include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
 
+static FAutoConsoleCommandWithWorld CVarRespawnStats(
+	TEXT("TopDown.Respawn.Stats"),
+	TEXT("Log respawn scheduler queue depth and latency"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ATopDownGameMode* GameMode = World ? World->GetAuthGameMode<ATopDownGameMode>() : nullptr)
+		{
+			GameMode->LogRespawnStats();
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs CVarSpawnBots(
+	TEXT("TopDown.Bots.Spawn"),
+	TEXT("Spawn load-test bots on the server. Arg: number of bots (default 1)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ATopDownGameMode* GameMode = World ? World->GetAuthGameMode<ATopDownGameMode>() : nullptr)
+		{
+			GameMode->SpawnBots(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1);
+		}
+	})
+);
+
 ATopDownGameMode::ATopDownGameMode()
 {
+	// Tick drains the respawn queue
+	PrimaryActorTick.bCanEverTick = true;
+
 	// Set default game state class
 	GameStateClass = ATopDownGameState::StaticClass();
 
@@ -21,13 +59,66 @@ ATopDownGameMode::ATopDownGameMode()
 	// Set default player controller class
 	PlayerControllerClass = ATopDownPlayerController::StaticClass();
 
+	// Load-test bots (-bots=N)
+	BotControllerClass = ATopDownBotController::StaticClass();
+
 	// Set default respawn delay (3 seconds)
 	RespawnDelay = 3.0f;
 
+	// Spawn point index
+	SpawnClaimDuration = 1.0f;            // Other spawns avoid a start for 1 second after it is used
+	SpawnPointCursor = 0;
+	SpawnScoreFrame = 0;
+
+	// Respawn scheduler
+	MaxRespawnsPerFrame = 4;              // A 50-player wipe comes back over ~13 frames instead of one
+	PeakRespawnQueueDepth = 0;
+	TotalRespawns = 0;
+	RateLimitedFrames = 0;
+	TotalRespawnLateness = 0.0f;
+	MaxRespawnLateness = 0.0f;
+
 	// Enable replication
 	bReplicates = true;
 }
 
+void ATopDownGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// One combat journal file per match
+	FCombatJournal::Get().BeginJournal(GetWorld()->GetMapName());
+
+	CacheSpawnPoints();
+
+	// Headless load test on the dedicated server: TopDownProtoServer Arena -bots=64
+	// (TopDown.Bots.Spawn still adds bots by hand on any instance with authority)
+	int32 NumBots = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("bots="), NumBots) && NumBots > 0)
+	{
+		if (GetNetMode() != NM_DedicatedServer)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("-bots=%d ignored: the load test measures dedicated server capacity (run TopDownProtoServer, or -server -nullrhi)"), NumBots);
+		}
+		else
+		{
+			SpawnBots(NumBots);
+
+			if (ULoadTestSubsystem* LoadTest = GetWorld()->GetSubsystem<ULoadTestSubsystem>())
+			{
+				LoadTest->StartLoadTest(NumBots);
+			}
+		}
+	}
+}
+
+void ATopDownGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ProcessRespawnQueue();
+}
+
 void ATopDownGameMode::PostLogin(APlayerController* NewPlayer)
 {
 	Super::PostLogin(NewPlayer);
@@ -82,60 +173,160 @@ void ATopDownGameMode::RequestRespawn(AController* Controller)
 		return;
 	}
 
-	// Destroy current pawn if it exists
+	// Dead characters go back to the pool after their ragdoll window; anything else is destroyed
 	if (APawn* OldPawn = Controller->GetPawn())
 	{
-		OldPawn->Destroy();
+		ATopDownCharacter* OldCharacter = Cast<ATopDownCharacter>(OldPawn);
+		UCharacterPoolSubsystem* CharacterPool = GetWorld()->GetSubsystem<UCharacterPoolSubsystem>();
+		if (OldCharacter && CharacterPool)
+		{
+			CharacterPool->ReleaseCharacter(OldCharacter);
+		}
+		else
+		{
+			OldPawn->Destroy();
+		}
 	}
 
-	// Schedule respawn after delay
-	if (RespawnDelay > 0.0f)
+	QueueRespawn(Controller, RespawnDelay);
+}
+
+void ATopDownGameMode::QueueRespawn(AController* Controller, float Delay)
+{
+	// Already waiting (e.g. killed again by a late event) - keep the original slot
+	if (RespawnQueue.ContainsByPredicate([Controller](const FTopDownPendingRespawn& Pending) { return Pending.Controller == Controller; }))
 	{
-		FTimerDelegate RespawnDelegate;
-		RespawnDelegate.BindUObject(this, &ATopDownGameMode::HandleRespawn, Controller);
-		
-		GetWorldTimerManager().SetTimer(
-			RespawnTimerHandle,
-			RespawnDelegate,
-			RespawnDelay,
-			false
-		);
+		return;
+	}
+
+	// Queue the respawn; Tick spawns it once due (a zero delay spawns on this frame's tick)
+	FTopDownPendingRespawn Pending;
+	Pending.DueTime = GetWorld()->GetTimeSeconds() + FMath::Max(Delay, 0.0f);
+	Pending.Controller = Controller;
+	RespawnQueue.HeapPush(Pending);
+
+	PeakRespawnQueueDepth = FMath::Max(PeakRespawnQueueDepth, RespawnQueue.Num());
+	TOPDOWN_SET_COUNTER(RespawnQueueDepth, RespawnQueue.Num());
+
+	UE_LOG(LogTemp, Log, TEXT("Respawn scheduled for %s in %.1f seconds (%d queued)"),
+		*Controller->GetName(), Delay, RespawnQueue.Num());
+}
 
-		UE_LOG(LogTemp, Log, TEXT("Respawn scheduled for %s in %.1f seconds"), 
-			*Controller->GetName(), RespawnDelay);
+void ATopDownGameMode::ProcessRespawnQueue()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	int32 NumRespawned = 0;
+
+	while (RespawnQueue.Num() > 0 && RespawnQueue.HeapTop().DueTime <= Now)
+	{
+		// Leave the rest for the next frames rather than hitching this one
+		if (NumRespawned >= MaxRespawnsPerFrame)
+		{
+			++RateLimitedFrames;
+			break;
+		}
+
+		FTopDownPendingRespawn Pending;
+		RespawnQueue.HeapPop(Pending, EAllowShrinking::No);
+
+		if (AController* Controller = Pending.Controller.Get())
+		{
+			const float Lateness = Now - Pending.DueTime;
+			TotalRespawnLateness += Lateness;
+			MaxRespawnLateness = FMath::Max(MaxRespawnLateness, Lateness);
+			++TotalRespawns;
+			++NumRespawned;
+
+			HandleRespawn(Controller);
+		}
 	}
-	else
+
+	if (NumRespawned > 0)
+	{
+		TOPDOWN_INC_COUNTER(Respawns, NumRespawned);
+		TOPDOWN_SET_COUNTER(RespawnQueueDepth, RespawnQueue.Num());
+	}
+}
+
+void ATopDownGameMode::LogRespawnStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Respawn scheduler: %d queued (peak %d), %d respawned, %d rate-limited frames, lateness avg %.1f ms / max %.1f ms (limit %d per frame)"),
+	       RespawnQueue.Num(), PeakRespawnQueueDepth, TotalRespawns, RateLimitedFrames,
+	       TotalRespawns > 0 ? TotalRespawnLateness * 1000.0f / TotalRespawns : 0.0f, MaxRespawnLateness * 1000.0f,
+	       MaxRespawnsPerFrame);
+}
+
+TArray<ATopDownBotController*> ATopDownGameMode::SpawnBots(int32 NumBots)
+{
+	TArray<ATopDownBotController*> Bots;
+	if (!HasAuthority() || !BotControllerClass)
 	{
-		// Respawn immediately if delay is 0
-		HandleRespawn(Controller);
+		UE_LOG(LogTemp, Warning, TEXT("SpawnBots called without authority or bot controller class"));
+		return Bots;
 	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		ATopDownBotController* Bot = GetWorld()->SpawnActor<ATopDownBotController>(BotControllerClass, SpawnParams);
+		if (!Bot)
+		{
+			continue;
+		}
+
+		if (Bot->PlayerState)
+		{
+			Bot->PlayerState->SetPlayerName(FString::Printf(TEXT("Bot%03d"), Index));
+		}
+
+		// Same spawn path as a respawn (spawn point claims, character pool), and the same
+		// MaxRespawnsPerFrame budget, so a large -bots=N comes in over several frames
+		QueueRespawn(Bot, 0.0f);
+		Bots.Add(Bot);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Spawned %d bots (characters queued for spawn)"), Bots.Num());
+	return Bots;
 }
 
 void ATopDownGameMode::HandleRespawn(AController* Controller)
 {
+	TOPDOWN_SCOPE_CYCLE_COUNTER(HandleRespawn);
+
 	if (!Controller)
 	{
 		return;
 	}
 
-	// Find a spawn point
-	AActor* SpawnPoint = FindPlayerStart(Controller);
+	// Find a spawn point (through ChoosePlayerStart, so the engine's choice covers stale cached starts)
+	AActor* SpawnPoint = ChoosePlayerStart(Controller);
 	if (!SpawnPoint)
 	{
 		UE_LOG(LogTemp, Error, TEXT("No valid spawn point found for respawn"));
 		return;
 	}
 
-	// Spawn new pawn
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	// Reuse a pooled character when possible (teleport and reset instead of a full actor lifecycle)
+	APawn* NewPawn = nullptr;
+	UCharacterPoolSubsystem* CharacterPool = GetWorld()->GetSubsystem<UCharacterPoolSubsystem>();
+	if (CharacterPool && DefaultPawnClass && DefaultPawnClass->IsChildOf(ATopDownCharacter::StaticClass()))
+	{
+		NewPawn = CharacterPool->AcquireCharacter(DefaultPawnClass.Get(), SpawnPoint->GetActorLocation(), SpawnPoint->GetActorRotation());
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	APawn* NewPawn = GetWorld()->SpawnActor<APawn>(
-		DefaultPawnClass,
-		SpawnPoint->GetActorLocation(),
-		SpawnPoint->GetActorRotation(),
-		SpawnParams
-	);
+		NewPawn = GetWorld()->SpawnActor<APawn>(
+			DefaultPawnClass,
+			SpawnPoint->GetActorLocation(),
+			SpawnPoint->GetActorRotation(),
+			SpawnParams
+		);
+	}
 
 	if (NewPawn)
 	{
@@ -149,6 +340,7 @@ void ATopDownGameMode::HandleRespawn(AController* Controller)
 		}
 
 		UE_LOG(LogTemp, Log, TEXT("Player respawned: %s"), *Controller->GetName());
+		FCombatJournal::Get().Record(ECombatJournalEvent::Respawn, nullptr, Controller, NewPawn->GetActorLocation());
 	}
 	else
 	{
@@ -158,59 +350,108 @@ void ATopDownGameMode::HandleRespawn(AController* Controller)
 
 AActor* ATopDownGameMode::FindPlayerStart(AController* Player)
 {
-	// Collect all player starts in the level
-	TArray<AActor*> PlayerStarts;
-	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	TOPDOWN_SCOPE_CYCLE_COUNTER(FindPlayerStart);
+
+	// Players can log in before BeginPlay has cached the starts
+	if (SpawnPoints.Num() == 0)
 	{
-		PlayerStarts.Add(*It);
+		CacheSpawnPoints();
 	}
 
-	if (PlayerStarts.Num() == 0)
+	if (SpawnPoints.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No PlayerStart actors found in level"));
 		return nullptr;
 	}
 
-	// Simple strategy: find the player start farthest from other players
-	AActor* BestStart = nullptr;
-	float BestDistance = 0.0f;
+	RefreshSpawnScores();
 
-	for (AActor* StartActor : PlayerStarts)
+	// Hand out starts best-first; claimed ones (used by a spawn moments ago) are skipped
+	const float Now = GetWorld()->GetTimeSeconds();
+	while (SpawnPointCursor < SpawnPointOrder.Num())
 	{
-		if (!StartActor)
+		FTopDownSpawnPoint& SpawnPoint = SpawnPoints[SpawnPointOrder[SpawnPointCursor++]];
+		if (IsValid(SpawnPoint.Start) && SpawnPoint.ClaimedUntil <= Now)
 		{
-			continue;
+			SpawnPoint.ClaimedUntil = Now + SpawnClaimDuration;
+			return SpawnPoint.Start;
 		}
+	}
 
-		// Calculate minimum distance to any other player
-		float MinDistanceToPlayer = MAX_FLT;
-		
-		for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	// Every start is claimed: reuse the best one still in the level (destroyed starts are scored last)
+	for (int32 SpawnPointIndex : SpawnPointOrder)
+	{
+		if (IsValid(SpawnPoints[SpawnPointIndex].Start))
 		{
-			APlayerController* PC = Iterator->Get();
-			if (PC && PC->GetPawn() && PC != Player)
-			{
-				float Distance = FVector::Dist(
-					StartActor->GetActorLocation(),
-					PC->GetPawn()->GetActorLocation()
-				);
-				MinDistanceToPlayer = FMath::Min(MinDistanceToPlayer, Distance);
-			}
+			return SpawnPoints[SpawnPointIndex].Start;
 		}
+	}
 
-		// Choose the start with maximum minimum distance (farthest from nearest player)
-		if (MinDistanceToPlayer > BestDistance)
-		{
-			BestDistance = MinDistanceToPlayer;
-			BestStart = StartActor;
-		}
+	return nullptr;
+}
+
+void ATopDownGameMode::CacheSpawnPoints()
+{
+	SpawnPoints.Reset();
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		FTopDownSpawnPoint& SpawnPoint = SpawnPoints.AddDefaulted_GetRef();
+		SpawnPoint.Start = *It;
+		SpawnPoint.Location = It->GetActorLocation();
 	}
 
-	// If no good start was found (e.g., no other players), just use the first one
-	if (!BestStart && PlayerStarts.Num() > 0)
+	SpawnPointOrder.Reset();
+	SpawnScoreFrame = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("Cached %d spawn points"), SpawnPoints.Num());
+}
+
+void ATopDownGameMode::RefreshSpawnScores()
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(ScoreSpawnPoints);
+
+	if (SpawnScoreFrame == GFrameCounter && SpawnPointOrder.Num() == SpawnPoints.Num())
 	{
-		BestStart = PlayerStarts[0];
+		return;
 	}
+	SpawnScoreFrame = GFrameCounter;
+
+	// Grid queries are read-only and the grid only changes on the game thread, so starts can be scored in parallel
+	const USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>();
+	auto IsLivingCharacter = [](const AActor* Candidate)
+	{
+		const ATopDownCharacter* Character = Cast<ATopDownCharacter>(Candidate);
+		return !Character || !Character->IsDead();
+	};
 
-	return BestStart;
+	ParallelFor(SpawnPoints.Num(), [this, SpatialGrid, &IsLivingCharacter](int32 Index)
+	{
+		FTopDownSpawnPoint& SpawnPoint = SpawnPoints[Index];
+
+		// Starts destroyed since they were cached sort behind every live one
+		if (!IsValid(SpawnPoint.Start))
+		{
+			SpawnPoint.NearestCharacterDistSq = -1.0f;
+			return;
+		}
+		SpawnPoint.NearestCharacterDistSq = MAX_FLT;
+
+		FSpatialGridHit Nearest;
+		if (SpatialGrid && SpatialGrid->FindNearest(SpawnPoint.Location, ESpatialGridCategory::Character,
+		                                            MakeArrayView(&Nearest, 1), IsLivingCharacter) > 0)
+		{
+			SpawnPoint.NearestCharacterDistSq = Nearest.DistSq;
+		}
+	});
+
+	SpawnPointOrder.SetNumUninitialized(SpawnPoints.Num());
+	for (int32 Index = 0; Index < SpawnPointOrder.Num(); ++Index)
+	{
+		SpawnPointOrder[Index] = Index;
+	}
+	SpawnPointOrder.StableSort([this](int32 A, int32 B)
+	{
+		return SpawnPoints[A].NearestCharacterDistSq > SpawnPoints[B].NearestCharacterDistSq;
+	});
+	SpawnPointCursor = 0;
 }
@@ -6,6 +6,47 @@
 #include "GameFramework/GameMode.h"
 #include "TopDownGameMode.generated.h"
 
+class ATopDownBotController;
+
+/**
+ * FTopDownSpawnPoint
+ *
+ * Player start cached at BeginPlay, with its score for the current frame.
+ */
+USTRUCT()
+struct FTopDownSpawnPoint
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AActor* Start = nullptr;
+
+	/** Start location (player starts don't move) */
+	FVector Location = FVector::ZeroVector;
+
+	/** Squared distance to the nearest living character, scored at most once per frame */
+	float NearestCharacterDistSq = MAX_FLT;
+
+	/** World time until which the start is reserved for a pawn that just spawned there */
+	float ClaimedUntil = 0.0f;
+};
+
+/**
+ * FTopDownPendingRespawn
+ *
+ * Entry of the respawn min-heap (ordered by due time).
+ */
+struct FTopDownPendingRespawn
+{
+	/** World time the respawn becomes due */
+	float DueTime = 0.0f;
+
+	/** Controller to respawn (gone if the player logged out while waiting) */
+	TWeakObjectPtr<AController> Controller;
+
+	bool operator<(const FTopDownPendingRespawn& Other) const { return DueTime < Other.DueTime; }
+};
+
 /**
  * ATopDownGameMode
  * 
@@ -17,9 +58,17 @@ class ATopDownGameMode : public AGameMode
 {
 	GENERATED_BODY()
 
+	/** Benchmarks drive the spawn point index directly */
+	friend class FTopDownPerfSuite;
+
 public:
 	ATopDownGameMode();
 
+	//~ Begin AActor Interface
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+	//~ End AActor Interface
+
 	//~ Begin AGameMode Interface
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 	virtual void Logout(AController* Exiting) override;
@@ -30,17 +79,92 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GameMode")
 	void RequestRespawn(AController* Controller);
 
+	/** Respawns waiting in the queue (not yet due, or held back by the per-frame limit) */
+	UFUNCTION(BlueprintPure, Category = "GameMode|Respawn")
+	int32 GetRespawnQueueDepth() const { return RespawnQueue.Num(); }
+
+	/** Largest queue depth seen this match */
+	UFUNCTION(BlueprintPure, Category = "GameMode|Respawn")
+	int32 GetPeakRespawnQueueDepth() const { return PeakRespawnQueueDepth; }
+
+	/** Log respawn scheduler metrics */
+	void LogRespawnStats() const;
+
+	/**
+	 * Spawn load-test bots and queue a character for each at a player start (server only)
+	 * @param NumBots - Number of bots to add
+	 * @return The bot controllers spawned (their characters arrive through the respawn queue)
+	 */
+	TArray<ATopDownBotController*> SpawnBots(int32 NumBots);
+
 protected:
 	/** Default respawn delay in seconds */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameMode|Respawn")
 	float RespawnDelay;
 
-	/** Timer handle for respawn */
-	FTimerHandle RespawnTimerHandle;
+	/** Controller class for SpawnBots (-bots=N) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameMode|Bots")
+	TSubclassOf<ATopDownBotController> BotControllerClass;
+
+	/** Maximum respawns performed in one frame; the rest wait for the next frames */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameMode|Respawn", meta = (ClampMin = "1"))
+	int32 MaxRespawnsPerFrame;
+
+	/**
+	 * Add a controller to the respawn queue (no-op if it is already waiting)
+	 * @param Controller - Controller to give a new pawn
+	 * @param Delay - Seconds until the respawn is due
+	 */
+	void QueueRespawn(AController* Controller, float Delay);
+
+	/** Spawn every due respawn, up to MaxRespawnsPerFrame */
+	void ProcessRespawnQueue();
 
 	/** Handle actual respawn logic */
 	void HandleRespawn(AController* Controller);
 
-	/** Find a suitable spawn point for a player */
+	/** Find a suitable spawn point for a player (best-scored unclaimed start; null if every cached start was destroyed) */
 	AActor* FindPlayerStart(AController* Player);
+
+	// ========================================================================================
+	// Spawn Point Index
+	// ========================================================================================
+
+	/** How long a chosen start is skipped by later spawns, so simultaneous respawns spread out */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameMode|Respawn", meta = (ClampMin = "0.0"))
+	float SpawnClaimDuration;
+
+	/** Collect the level's player starts into SpawnPoints */
+	void CacheSpawnPoints();
+
+	/** Score every spawn point against the spatial grid in parallel (no-op if already scored this frame) */
+	void RefreshSpawnScores();
+
+private:
+	/** Cached player starts */
+	UPROPERTY()
+	TArray<FTopDownSpawnPoint> SpawnPoints;
+
+	/** Indices into SpawnPoints, best score (farthest from any living character) first */
+	TArray<int32> SpawnPointOrder;
+
+	/** Next entry of SpawnPointOrder to hand out this frame */
+	int32 SpawnPointCursor;
+
+	/** Frame the scores were last computed on */
+	uint64 SpawnScoreFrame;
+
+	// ========================================================================================
+	// Respawn Scheduler
+	// ========================================================================================
+
+	/** Pending respawns, a min-heap on due time */
+	TArray<FTopDownPendingRespawn> RespawnQueue;
+
+	/** Metrics */
+	int32 PeakRespawnQueueDepth;
+	int32 TotalRespawns;
+	int32 RateLimitedFrames;
+	float TotalRespawnLateness;
+	float MaxRespawnLateness;
 };
@@ -32,6 +32,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "GameState")
 	float GetMatchTime() const;
 
+	/** Get server world time the match started at (match clock origin) */
+	UFUNCTION(BlueprintPure, Category = "GameState")
+	float GetMatchStartTime() const { return MatchStartTime; }
+
 	/** Increment player count (server only) */
 	void AddPlayer();
 
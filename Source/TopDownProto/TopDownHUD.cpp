@@ -3,6 +3,8 @@
 #include "TopDownHUD.h"
 #include "TopDownCharacter.h"
 #include "WeaponComponent.h"
+#include "TopDownStats.h"
+#include "Engine/World.h"
 
 void UTopDownHUD::InitializeHUD(ATopDownCharacter* InOwnerCharacter)
 {
@@ -17,6 +19,24 @@ void UTopDownHUD::InitializeHUD(ATopDownCharacter* InOwnerCharacter)
 	}
 }
 
+void UTopDownHUD::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UTopDownHUD::OnWorldPostActorTick);
+
+	// Anything that changed while we were off screen
+	MarkDirty(EHUDDirtyFlags::All);
+}
+
+void UTopDownHUD::NativeDestruct()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	Super::NativeDestruct();
+}
+
 void UTopDownHUD::UpdateHUD()
 {
 	if (!OwnerCharacter)
@@ -24,17 +44,94 @@ void UTopDownHUD::UpdateHUD()
 		return;
 	}
 
+	TOPDOWN_INC_COUNTER(HUDUpdates, 1);
+	TOPDOWN_INC_COUNTER(HUDEvents, 3);
+
 	// Update health display
-	float CurrentHealth = GetCurrentHealth();
-	float MaxHealth = GetMaxHealth();
-	float HealthPercent = GetHealthPercent();
-	OnHealthChanged(CurrentHealth, MaxHealth, HealthPercent);
+	ShownHealth = GetCurrentHealth();
+	ShownMaxHealth = GetMaxHealth();
+	OnHealthChanged(ShownHealth, ShownMaxHealth, GetHealthPercent());
 
 	// Update ammo display
-	int32 CurrentAmmo = GetCurrentAmmo();
-	int32 ReserveAmmo = GetReserveAmmo();
-	int32 MagazineSize = GetMagazineSize();
-	OnAmmoChanged(CurrentAmmo, ReserveAmmo, MagazineSize);
+	ShownAmmo = GetCurrentAmmo();
+	ShownReserveAmmo = GetReserveAmmo();
+	ShownMagazineSize = GetMagazineSize();
+	OnAmmoChanged(ShownAmmo, ShownReserveAmmo, ShownMagazineSize);
+
+	// Update weapon state display
+	const UWeaponComponent* Weapon = OwnerCharacter->GetWeaponComponent();
+	ShownWeaponState = Weapon ? Weapon->GetWeaponState() : EWeaponState::Idle;
+	bHasShownWeaponState = true;
+	OnWeaponStateChanged(ShownWeaponState);
+
+	DirtyFields = EHUDDirtyFlags::None;
+}
+
+void UTopDownHUD::MarkDirty(EHUDDirtyFlags Fields)
+{
+	DirtyFields |= Fields;
+}
+
+void UTopDownHUD::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (DirtyFields != EHUDDirtyFlags::None && World == GetWorld())
+	{
+		FlushDirtyFields();
+	}
+}
+
+void UTopDownHUD::FlushDirtyFields()
+{
+	const EHUDDirtyFlags Fields = DirtyFields;
+	DirtyFields = EHUDDirtyFlags::None;
+
+	if (!OwnerCharacter)
+	{
+		return;
+	}
+
+	TOPDOWN_INC_COUNTER(HUDUpdates, 1);
+
+	if (EnumHasAnyFlags(Fields, EHUDDirtyFlags::Health))
+	{
+		const float CurrentHealth = GetCurrentHealth();
+		const float MaxHealth = GetMaxHealth();
+		if (CurrentHealth != ShownHealth || MaxHealth != ShownMaxHealth)
+		{
+			ShownHealth = CurrentHealth;
+			ShownMaxHealth = MaxHealth;
+			OnHealthChanged(CurrentHealth, MaxHealth, GetHealthPercent());
+			TOPDOWN_INC_COUNTER(HUDEvents, 1);
+		}
+	}
+
+	if (EnumHasAnyFlags(Fields, EHUDDirtyFlags::Ammo | EHUDDirtyFlags::Reserve))
+	{
+		const int32 CurrentAmmo = GetCurrentAmmo();
+		const int32 ReserveAmmo = GetReserveAmmo();
+		const int32 MagazineSize = GetMagazineSize();
+		if (CurrentAmmo != ShownAmmo || ReserveAmmo != ShownReserveAmmo || MagazineSize != ShownMagazineSize)
+		{
+			ShownAmmo = CurrentAmmo;
+			ShownReserveAmmo = ReserveAmmo;
+			ShownMagazineSize = MagazineSize;
+			OnAmmoChanged(CurrentAmmo, ReserveAmmo, MagazineSize);
+			TOPDOWN_INC_COUNTER(HUDEvents, 1);
+		}
+	}
+
+	if (EnumHasAnyFlags(Fields, EHUDDirtyFlags::State))
+	{
+		const UWeaponComponent* Weapon = OwnerCharacter->GetWeaponComponent();
+		const EWeaponState WeaponState = Weapon ? Weapon->GetWeaponState() : EWeaponState::Idle;
+		if (!bHasShownWeaponState || WeaponState != ShownWeaponState)
+		{
+			ShownWeaponState = WeaponState;
+			bHasShownWeaponState = true;
+			OnWeaponStateChanged(WeaponState);
+			TOPDOWN_INC_COUNTER(HUDEvents, 1);
+		}
+	}
 }
 
 // ========================================================================================
@@ -4,10 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "WeaponComponent.h"
 #include "TopDownHUD.generated.h"
 
 class ATopDownCharacter;
 
+/**
+ * EHUDDirtyFlags
+ *
+ * HUD fields that changed since the last flush
+ */
+enum class EHUDDirtyFlags : uint8
+{
+	None    = 0,
+	Health  = 1 << 0,   // Health, max health, dead
+	Ammo    = 1 << 1,   // Magazine ammo
+	Reserve = 1 << 2,   // Reserve ammo
+	State   = 1 << 3,   // Weapon state (idle, firing, reloading)
+	All     = Health | Ammo | Reserve | State
+};
+ENUM_CLASS_FLAGS(EHUDDirtyFlags);
+
 /**
  * UTopDownHUD
  * 
@@ -17,12 +34,19 @@ class ATopDownCharacter;
  * - Crosshair
  * 
  * Designed to be subclassed in Blueprint for visual design.
+ *
+ * Gameplay code marks fields dirty (MarkDirty); dirty fields are flushed at most once per
+ * frame after actors and tickables have ticked, and each Blueprint event only fires when a
+ * field it shows actually changed, so several replicated changes in one frame cost one redraw.
  */
 UCLASS()
 class TOPDOWNPROTO_API UTopDownHUD : public UUserWidget
 {
 	GENERATED_BODY()
 
+	/** Benchmarks time the dirty-field flush directly */
+	friend class FTopDownPerfSuite;
+
 public:
 	/**
 	 * Initialize HUD with owner character
@@ -32,12 +56,23 @@ public:
 	void InitializeHUD(ATopDownCharacter* InOwnerCharacter);
 
 	/**
-	 * Update HUD display (called from C++ or Blueprint)
+	 * Redraw every field now (called from C++ or Blueprint)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "HUD")
 	void UpdateHUD();
 
+	/**
+	 * Flag fields for the end-of-frame flush
+	 * @param Fields - Fields that may have changed
+	 */
+	void MarkDirty(EHUDDirtyFlags Fields);
+
 protected:
+	//~ Begin UUserWidget Interface
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	//~ End UUserWidget Interface
+
 	/** Cached reference to owner character */
 	UPROPERTY(BlueprintReadOnly, Category = "HUD")
 	ATopDownCharacter* OwnerCharacter;
@@ -60,6 +95,13 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
 	void OnAmmoChanged(int32 CurrentAmmo, int32 ReserveAmmo, int32 MagazineSize);
 
+	/**
+	 * Called when the weapon state changes
+	 * Implement in Blueprint to show reload progress or firing indicators
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnWeaponStateChanged(EWeaponState WeaponState);
+
 	// ========================================================================================
 	// Helper Functions (Blueprint Callable)
 	// ========================================================================================
@@ -105,5 +147,25 @@ protected:
 	 */
 	UFUNCTION(BlueprintPure, Category = "HUD")
 	bool IsCharacterDead() const;
-};
 
+private:
+	/** World post-actor-tick hook: flush dirty fields once per frame */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Fire Blueprint events for dirty fields whose values changed */
+	void FlushDirtyFields();
+
+	/** Fields marked since the last flush */
+	EHUDDirtyFlags DirtyFields = EHUDDirtyFlags::None;
+
+	/** Values last shown (events are skipped when a dirty field did not actually change) */
+	float ShownHealth = -1.0f;
+	float ShownMaxHealth = -1.0f;
+	int32 ShownAmmo = INDEX_NONE;
+	int32 ShownReserveAmmo = INDEX_NONE;
+	int32 ShownMagazineSize = INDEX_NONE;
+	EWeaponState ShownWeaponState = EWeaponState::Idle;
+	bool bHasShownWeaponState = false;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,498 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownMovementComponent.h"
+#include "TopDownCharacter.h"
+#include "TopDownStats.h"
+#include "TopDownReplicationGraph.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/CoreNet.h"
+
+static TAutoConsoleVariable<int32> CVarTopDownPlanarMovement(
+	TEXT("TopDown.Movement.Planar"),
+	1,
+	TEXT("Planar movement optimizations (flat floor check, no step-up, reduced-rate distant proxies). 0 = stock character movement paths"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithWorldAndArgs CVarTopDownMovementBenchmark(
+	TEXT("TopDown.Movement.Benchmark"),
+	TEXT("Compare stock and planar character movement server cost. Optional args: character counts (default 16 64 128)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		TArray<int32> CharacterCounts;
+		for (const FString& Arg : Args)
+		{
+			CharacterCounts.Add(FCString::Atoi(*Arg));
+		}
+		if (CharacterCounts.Num() == 0)
+		{
+			CharacterCounts = { 16, 64, 128 };
+		}
+
+		UTopDownMovementComponent::RunBenchmark(World, CharacterCounts);
+	})
+);
+
+// ========================================================================================
+// Saved Move
+// ========================================================================================
+
+void FTopDownSavedMove::Clear()
+{
+	Super::Clear();
+
+	SavedAimYaw = 0;
+	bAimYawDirty = true;
+}
+
+void FTopDownSavedMove::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	SavedAimYaw = FRotator::CompressAxisToShort(C->GetActorRotation().Yaw);
+
+	// Keep sending a new yaw until the server has acknowledged a move carrying it
+	const FTopDownSavedMove* LastAckedMove = static_cast<const FTopDownSavedMove*>(ClientData.LastAckedMove.Get());
+	bAimYawDirty = !LastAckedMove || LastAckedMove->SavedAimYaw != SavedAimYaw;
+}
+
+bool FTopDownSavedMove::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	// Aim yaw is deliberately not compared: it changes nearly every frame while aiming, and refusing
+	// to combine would send a ServerMove per frame. The combined move keeps the newest yaw (CombineWith)
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FTopDownSavedMove::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	// Super rewinds the character to the pending move's start rotation; this (newer) move already
+	// holds the latest yaw and dirty flag from SetMoveFor, so just re-apply that aim
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	if (InCharacter)
+	{
+		InCharacter->SetActorRotation(FRotator(0.0f, FRotator::DecompressAxisFromShort(SavedAimYaw), 0.0f));
+	}
+}
+
+void FTopDownSavedMove::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	// Replay with the aim the move was originally made with
+	C->SetActorRotation(FRotator(0.0f, FRotator::DecompressAxisFromShort(SavedAimYaw), 0.0f));
+}
+
+FSavedMovePtr FTopDownNetworkPredictionData_Client::AllocateNewMove()
+{
+	return FSavedMovePtr(new FTopDownSavedMove());
+}
+
+// ========================================================================================
+// Network Move Data
+// ========================================================================================
+
+void FTopDownNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FTopDownSavedMove& TopDownMove = static_cast<const FTopDownSavedMove&>(ClientMove);
+	AimYaw = TopDownMove.SavedAimYaw;
+	bHasAimYaw = TopDownMove.bAimYawDirty;
+
+	if (bHasAimYaw)
+	{
+		INC_DWORD_STAT(STAT_TopDownAimYawSent);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_TopDownAimYawSkipped);
+	}
+}
+
+bool FTopDownNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	uint8 bSendAimYaw = bHasAimYaw ? 1 : 0;
+	Ar.SerializeBits(&bSendAimYaw, 1);
+	bHasAimYaw = bSendAimYaw != 0;
+
+	if (bHasAimYaw)
+	{
+		Ar << AimYaw;
+	}
+
+	return !Ar.IsError();
+}
+
+FTopDownNetworkMoveDataContainer::FTopDownNetworkMoveDataContainer()
+{
+	NewMoveData = &TopDownMoveData[0];
+	PendingMoveData = &TopDownMoveData[1];
+	OldMoveData = &TopDownMoveData[2];
+}
+
+// ========================================================================================
+// Planar Replicated Movement
+// ========================================================================================
+
+namespace TopDownRepMovement
+{
+	/** Largest magnitude sent (keeps the width header within 5 bits and Abs() defined) */
+	constexpr int32 MaxMagnitude = (1 << 30) - 1;
+
+	int32 Quantize(double Value)
+	{
+		return FMath::Clamp(FMath::RoundToInt32(Value), -MaxMagnitude, MaxMagnitude);
+	}
+
+	/** Sign and magnitude per value, with one shared width header for the group */
+	void SerializeComponents(FArchive& Ar, TArrayView<int32> Values)
+	{
+		uint32 Width = 0;
+		if (Ar.IsSaving())
+		{
+			int32 MaxAbs = 0;
+			for (const int32 Value : Values)
+			{
+				MaxAbs = FMath::Max(MaxAbs, FMath::Abs(Value));
+			}
+			Width = FMath::CeilLogTwo(static_cast<uint32>(MaxAbs) + 1);
+		}
+		Ar.SerializeInt(Width, 1u << FTopDownRepMovement::WidthBits);
+
+		for (int32& Value : Values)
+		{
+			uint8 bNegative = Value < 0 ? 1 : 0;
+			uint32 Magnitude = static_cast<uint32>(FMath::Abs(Value));
+			if (Width > 0)
+			{
+				Ar.SerializeBits(&bNegative, 1);
+				Ar.SerializeInt(Magnitude, 1u << Width);
+			}
+			else
+			{
+				bNegative = 0;
+				Magnitude = 0;
+			}
+			Value = bNegative ? -static_cast<int32>(Magnitude) : static_cast<int32>(Magnitude);
+		}
+	}
+}
+
+FTopDownRepMovement FTopDownRepMovement::FromRepMovement(const FRepMovement& RepMovement)
+{
+	FTopDownRepMovement Result;
+	Result.X = TopDownRepMovement::Quantize(RepMovement.Location.X);
+	Result.Y = TopDownRepMovement::Quantize(RepMovement.Location.Y);
+	Result.Z = TopDownRepMovement::Quantize(RepMovement.Location.Z);
+	Result.VelocityX = TopDownRepMovement::Quantize(RepMovement.LinearVelocity.X);
+	Result.VelocityY = TopDownRepMovement::Quantize(RepMovement.LinearVelocity.Y);
+	Result.VelocityZ = TopDownRepMovement::Quantize(RepMovement.LinearVelocity.Z);
+	Result.Yaw = FRotator::CompressAxisToShort(RepMovement.Rotation.Yaw) >> (16 - YawBits);
+	return Result;
+}
+
+void FTopDownRepMovement::ToRepMovement(FRepMovement& OutRepMovement) const
+{
+	OutRepMovement.Location = FVector(X, Y, Z);
+	OutRepMovement.Rotation = FRotator(0.0f, FRotator::DecompressAxisFromShort(static_cast<uint16>(Yaw << (16 - YawBits))), 0.0f);
+	OutRepMovement.LinearVelocity = FVector(VelocityX, VelocityY, VelocityZ);
+	OutRepMovement.AngularVelocity = FVector::ZeroVector;
+	OutRepMovement.bRepPhysics = false;
+	OutRepMovement.bSimulatedPhysicSleep = false;
+}
+
+bool FTopDownRepMovement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	int32 Horizontal[2] = { X, Y };
+	TopDownRepMovement::SerializeComponents(Ar, Horizontal);
+
+	int32 Vertical[1] = { Z };
+	TopDownRepMovement::SerializeComponents(Ar, Vertical);
+
+	int32 HorizontalVelocity[2] = { VelocityX, VelocityY };
+	TopDownRepMovement::SerializeComponents(Ar, HorizontalVelocity);
+
+	// Vertical velocity is zero whenever the character is walking
+	uint8 bHasVerticalVelocity = VelocityZ != 0 ? 1 : 0;
+	Ar.SerializeBits(&bHasVerticalVelocity, 1);
+	int32 VerticalVelocity[1] = { bHasVerticalVelocity ? VelocityZ : 0 };
+	if (bHasVerticalVelocity)
+	{
+		TopDownRepMovement::SerializeComponents(Ar, VerticalVelocity);
+	}
+
+	uint32 PackedYaw = Yaw;
+	Ar.SerializeInt(PackedYaw, 1u << YawBits);
+
+	if (Ar.IsLoading())
+	{
+		X = Horizontal[0];
+		Y = Horizontal[1];
+		Z = Vertical[0];
+		VelocityX = HorizontalVelocity[0];
+		VelocityY = HorizontalVelocity[1];
+		VelocityZ = VerticalVelocity[0];
+		Yaw = static_cast<uint16>(PackedYaw);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// ========================================================================================
+// Movement Component
+// ========================================================================================
+
+UTopDownMovementComponent::UTopDownMovementComponent()
+{
+	SetNetworkMoveDataContainer(TopDownMoveDataContainer);
+}
+
+bool UTopDownMovementComponent::IsPlanarMovementEnabled()
+{
+	return CVarTopDownPlanarMovement.GetValueOnGameThread() != 0;
+}
+
+void UTopDownMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	UpdateSimulatedProxyTickInterval();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UTopDownMovementComponent::UpdateSimulatedProxyTickInterval()
+{
+	float DesiredTickInterval = 0.0f;
+
+	if (IsPlanarMovementEnabled() && CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		// Beyond the camera footprint nobody sees the proxy's smoothing, so simulate it less often
+		if (DistantProxyDistance <= 0.0f)
+		{
+			DistantProxyDistance = GetDefault<UTopDownReplicationGraph>()->GetViewFootprintRadius(GetWorld()) * DistantProxyFootprintScale;
+		}
+
+		const APlayerController* LocalController = GetWorld()->GetFirstPlayerController();
+		if (LocalController && FVector::DistSquared2D(LocalController->GetFocalLocation(), CharacterOwner->GetActorLocation()) > FMath::Square(DistantProxyDistance))
+		{
+			DesiredTickInterval = DistantProxyTickInterval;
+			INC_DWORD_STAT(STAT_TopDownDistantProxyTicks);
+		}
+	}
+
+	if (GetComponentTickInterval() != DesiredTickInterval)
+	{
+		SetComponentTickInterval(DesiredTickInterval);
+	}
+}
+
+void UTopDownMovementComponent::FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult) const
+{
+	if (!bFlatArenaFloor || !IsPlanarMovementEnabled() || !UpdatedComponent || !CharacterOwner)
+	{
+		Super::FindFloor(CapsuleLocation, OutFloorResult, bCanUseCachedLocation, DownwardSweepResult);
+		return;
+	}
+
+	// Flat arena: one line trace straight down from the capsule center replaces the capsule sweep
+	const float HalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float TraceDistance = HalfHeight + FMath::Max(MAX_FLOOR_DIST, MaxStepHeight);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TopDownFlatFloor), false, CharacterOwner);
+	FCollisionResponseParams ResponseParams;
+	InitCollisionParams(QueryParams, ResponseParams);
+
+	FHitResult Hit;
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, CapsuleLocation, CapsuleLocation - FVector(0.0f, 0.0f, TraceDistance),
+	                                                       UpdatedComponent->GetCollisionObjectType(), QueryParams, ResponseParams);
+
+	if (bHit && !Hit.bStartPenetrating && Hit.ImpactNormal.Z >= FlatFloorMinNormalZ && IsWalkable(Hit))
+	{
+		OutFloorResult.Clear();
+		OutFloorResult.SetFromSweep(Hit, Hit.Distance - HalfHeight, true);
+		INC_DWORD_STAT(STAT_TopDownFlatFloorChecks);
+		return;
+	}
+
+	// Slopes, ledges and anything else non-flat keep the full sweep
+	Super::FindFloor(CapsuleLocation, OutFloorResult, bCanUseCachedLocation, DownwardSweepResult);
+}
+
+bool UTopDownMovementComponent::CanStepUp(const FHitResult& Hit) const
+{
+	// Flat arenas have walls, not steps
+	if (bFlatArenaFloor && IsPlanarMovementEnabled())
+	{
+		return false;
+	}
+
+	return Super::CanStepUp(Hit);
+}
+
+void UTopDownMovementComponent::ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits)
+{
+	TOPDOWN_INC_COUNTER(RPCsReceived, 1);
+
+	Super::ServerMovePacked_ServerReceive(PackedBits);
+}
+
+FNetworkPredictionData_Client* UTopDownMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UTopDownMovementComponent* MutableThis = const_cast<UTopDownMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FTopDownNetworkPredictionData_Client(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UTopDownMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	// Server: apply the client's aim before simulating the move (only sent when it changed)
+	const FTopDownNetworkMoveData* MoveData = static_cast<const FTopDownNetworkMoveData*>(GetCurrentNetworkMoveData());
+	if (MoveData && MoveData->bHasAimYaw && CharacterOwner)
+	{
+		CharacterOwner->SetActorRotation(FRotator(0.0f, FRotator::DecompressAxisFromShort(MoveData->AimYaw), 0.0f));
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+// ========================================================================================
+// Benchmark
+// ========================================================================================
+
+void UTopDownMovementComponent::RunBenchmark(UWorld* World, const TArray<int32>& CharacterCounts)
+{
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Movement benchmark must run with authority"));
+		return;
+	}
+
+	constexpr int32 NumFrames = 120;
+	constexpr int32 FramesPerDirection = 30;
+	constexpr float FrameTime = 1.0f / 60.0f;
+	constexpr float Spacing = 250.0f;
+
+	FVector Origin(0.0f, 0.0f, 100.0f);
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	IConsoleVariable* PlanarVariable = CVarTopDownPlanarMovement.AsVariable();
+	const int32 PreviousPlanar = PlanarVariable->GetInt();
+
+	for (const int32 CharacterCount : CharacterCounts)
+	{
+		// Controller-less characters on a grid around the first player start
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const int32 Columns = FMath::Max(FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(CharacterCount))), 1);
+		TArray<ATopDownCharacter*> Spawned;
+		TArray<FVector> StartLocations;
+		for (int32 Index = 0; Index < CharacterCount; ++Index)
+		{
+			const FVector Location = Origin + FVector((Index % Columns) * Spacing, (Index / Columns) * Spacing, 0.0f);
+			if (ATopDownCharacter* Character = World->SpawnActor<ATopDownCharacter>(ATopDownCharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams))
+			{
+				Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+				Spawned.Add(Character);
+				StartLocations.Add(Location);
+			}
+		}
+
+		// Same inputs for both runs, so stock and planar simulate identical movement
+		auto RunMovement = [&](bool bPlanar)
+		{
+			PlanarVariable->Set(bPlanar ? 1 : 0, ECVF_SetByCode);
+
+			for (int32 Index = 0; Index < Spawned.Num(); ++Index)
+			{
+				Spawned[Index]->SetActorLocation(StartLocations[Index], false, nullptr, ETeleportType::ResetPhysics);
+				Spawned[Index]->GetCharacterMovement()->StopMovementImmediately();
+			}
+
+			FRandomStream Random(12345);
+			TArray<FVector> Inputs;
+			Inputs.SetNum(Spawned.Num());
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				for (int32 Index = 0; Index < Spawned.Num(); ++Index)
+				{
+					if (Frame % FramesPerDirection == 0)
+					{
+						const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+						Inputs[Index] = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+					}
+
+					UCharacterMovementComponent* Movement = Spawned[Index]->GetCharacterMovement();
+					Spawned[Index]->AddMovementInput(Inputs[Index]);
+					Movement->TickComponent(FrameTime, LEVELTICK_All, &Movement->PrimaryComponentTick);
+				}
+			}
+			return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) / NumFrames;
+		};
+
+		const double StockMs = RunMovement(false);
+		const double PlanarMs = RunMovement(true);
+
+		// Simulated-proxy movement packing: AActor::ReplicatedMovement vs. FTopDownRepMovement
+		int64 StockBits = 0;
+		int64 PlanarBits = 0;
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (ATopDownCharacter* Character : Spawned)
+		{
+			Character->GatherCurrentMovement();
+			FRepMovement RepMovement = Character->GetReplicatedMovement();
+
+			FNetBitWriter Writer(nullptr, 1024);
+			bool bSuccess = false;
+			RepMovement.NetSerialize(Writer, nullptr, bSuccess);
+			StockBits += Writer.GetNumBits();
+		}
+		const double StockPackUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (ATopDownCharacter* Character : Spawned)
+		{
+			Character->GatherCurrentMovement();
+			FTopDownRepMovement RepMovement = FTopDownRepMovement::FromRepMovement(Character->GetReplicatedMovement());
+
+			FNetBitWriter Writer(nullptr, 1024);
+			bool bSuccess = false;
+			RepMovement.NetSerialize(Writer, nullptr, bSuccess);
+			PlanarBits += Writer.GetNumBits();
+		}
+		const double PlanarPackUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+		const double NumCharacters = FMath::Max(Spawned.Num(), 1);
+		UE_LOG(LogTemp, Log, TEXT("Movement benchmark: %d characters | movement: stock %.3f ms/frame, planar %.3f ms/frame | replicated movement: stock %.1f bits %.3f us, planar %.1f bits %.3f us per character"),
+		       Spawned.Num(), StockMs, PlanarMs,
+		       StockBits / NumCharacters, StockPackUs / NumCharacters,
+		       PlanarBits / NumCharacters, PlanarPackUs / NumCharacters);
+
+		for (ATopDownCharacter* Character : Spawned)
+		{
+			Character->Destroy();
+		}
+	}
+
+	PlanarVariable->Set(PreviousPlanar, ECVF_SetByCode);
+}
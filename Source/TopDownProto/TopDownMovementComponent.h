@@ -0,0 +1,213 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "TopDownMovementComponent.generated.h"
+
+/**
+ * FTopDownSavedMove
+ *
+ * Saved move carrying the aim yaw the character had when the move was made.
+ * Aim changes don't prevent combining, so continuous aiming still benefits from the
+ * ClientNetSendMoveDeltaTime throttle; a combined move carries the newest yaw.
+ */
+class FTopDownSavedMove : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	/** Actor yaw at the time of the move (FRotator::CompressAxisToShort) */
+	uint16 SavedAimYaw = 0;
+
+	/** Yaw differs from the last move the server acknowledged, so it must be sent */
+	bool bAimYawDirty = true;
+
+	//~ Begin FSavedMove_Character Interface
+	virtual void Clear() override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+	//~ End FSavedMove_Character Interface
+};
+
+/**
+ * FTopDownNetworkPredictionData_Client
+ *
+ * Client prediction data allocating FTopDownSavedMove.
+ */
+class FTopDownNetworkPredictionData_Client : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FTopDownNetworkPredictionData_Client(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+/**
+ * FTopDownNetworkMoveData
+ *
+ * Move data sent to the server: stock movement plus an optional 16-bit aim yaw
+ * (one bit when the yaw hasn't changed since the last acknowledged move).
+ */
+struct FTopDownNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	uint16 AimYaw = 0;
+	bool bHasAimYaw = false;
+
+	//~ Begin FCharacterNetworkMoveData Interface
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+	//~ End FCharacterNetworkMoveData Interface
+};
+
+/**
+ * FTopDownNetworkMoveDataContainer
+ *
+ * Storage for the new/pending/old FTopDownNetworkMoveData of a packed ServerMove.
+ */
+struct FTopDownNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FTopDownNetworkMoveDataContainer();
+
+	FTopDownNetworkMoveData TopDownMoveData[3];
+};
+
+/**
+ * FTopDownRepMovement
+ *
+ * Planar replacement for AActor::ReplicatedMovement, sent to simulated proxies only.
+ * Values are quantized when packed (whole cm, whole cm/s, 12-bit yaw) so unchanged movement
+ * compares equal and is not resent. Horizontal pairs share an adaptive bit width; vertical
+ * velocity costs a single bit while grounded. Pitch, roll and physics state are not sent.
+ */
+USTRUCT()
+struct FTopDownRepMovement
+{
+	GENERATED_BODY()
+
+	int32 X = 0;
+	int32 Y = 0;
+	int32 Z = 0;
+	int32 VelocityX = 0;
+	int32 VelocityY = 0;
+	int32 VelocityZ = 0;
+	uint16 Yaw = 0;
+
+	/** Wire widths */
+	static constexpr uint32 WidthBits = 5;          // Bit width header for each component group
+	static constexpr uint32 YawBits = 12;           // ~0.09 degree steps
+
+	/** Quantize the movement gathered by AActor::GatherCurrentMovement */
+	static FTopDownRepMovement FromRepMovement(const FRepMovement& RepMovement);
+
+	/** Expand back into an FRepMovement for the stock simulated-proxy path */
+	void ToRepMovement(FRepMovement& OutRepMovement) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FTopDownRepMovement& Other) const
+	{
+		return X == Other.X && Y == Other.Y && Z == Other.Z
+			&& VelocityX == Other.VelocityX && VelocityY == Other.VelocityY && VelocityZ == Other.VelocityZ
+			&& Yaw == Other.Yaw;
+	}
+	bool operator!=(const FTopDownRepMovement& Other) const { return !(*this == Other); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FTopDownRepMovement> : public TStructOpsTypeTraitsBase2<FTopDownRepMovement>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/**
+ * UTopDownMovementComponent
+ *
+ * Character movement for the top-down shooter.
+ *
+ * Features:
+ * - Aim yaw rides the packed ServerMove (16 bits, skipped while unchanged) instead of a
+ *   separate rotation RPC, and is restored when moves are replayed after a correction
+ * - Flat arena floor check: a single line trace instead of the capsule sweep, no step-up
+ * - Simulated proxies far from the local view tick at a reduced rate
+ * - Planar simulated-proxy movement replication (FTopDownRepMovement, owned by ATopDownCharacter)
+ *
+ * The optimizations can be toggled at runtime with TopDown.Movement.Planar (0 = stock paths).
+ */
+UCLASS(config=Game)
+class TOPDOWNPROTO_API UTopDownMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTopDownMovementComponent();
+
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+	//~ Begin UCharacterMovementComponent Interface
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	virtual void FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult = nullptr) const override;
+	virtual bool CanStepUp(const FHitResult& Hit) const override;
+	virtual void ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits) override;
+	//~ End UCharacterMovementComponent Interface
+
+	/** Are the planar optimizations enabled (TopDown.Movement.Planar)? */
+	static bool IsPlanarMovementEnabled();
+
+	/**
+	 * Server CPU benchmark: stock vs. planar movement and replicated movement packing
+	 * Spawns each count of characters, simulates them without controllers and logs the results
+	 */
+	static void RunBenchmark(UWorld* World, const TArray<int32>& CharacterCounts);
+
+protected:
+	//~ Begin UCharacterMovementComponent Interface
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+	//~ End UCharacterMovementComponent Interface
+
+	// ========================================================================================
+	// Configuration (DefaultGame.ini)
+	// ========================================================================================
+
+	/** Use the line-trace floor check (arenas are flat; anything else falls back to the stock sweep) */
+	UPROPERTY(Config)
+	bool bFlatArenaFloor = true;
+
+	/** Minimum floor normal Z accepted by the line-trace floor check */
+	UPROPERTY(Config)
+	float FlatFloorMinNormalZ = 0.99f;
+
+	/**
+	 * Simulated proxies further than this multiple of the camera footprint radius from the local view
+	 * use DistantProxyTickInterval (same footprint UTopDownReplicationGraph culls with)
+	 */
+	UPROPERTY(Config)
+	float DistantProxyFootprintScale = 1.0f;
+
+	/** Tick interval for distant simulated proxies (0 = every frame) */
+	UPROPERTY(Config)
+	float DistantProxyTickInterval = 0.1f;
+
+private:
+	/** Switch simulated proxies between full and reduced tick rate based on distance to the local view */
+	void UpdateSimulatedProxyTickInterval();
+
+	/** Distance beyond which simulated proxies tick at the reduced rate (derived on first use, 0 = not yet) */
+	float DistantProxyDistance = 0.0f;
+
+	/** Move data storage used by the packed ServerMove RPC */
+	FTopDownNetworkMoveDataContainer TopDownMoveDataContainer;
+};
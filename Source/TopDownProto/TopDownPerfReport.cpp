@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownPerfReport.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+float TopDownPerf::Percentile(const TArray<float>& Sorted, float Fraction)
+{
+	if (Sorted.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Rank];
+}
+
+TSharedRef<FJsonObject> TopDownPerf::MakeDistribution(TArray<float> Values)
+{
+	Values.Sort();
+
+	double Sum = 0.0;
+	for (const float Value : Values)
+	{
+		Sum += Value;
+	}
+
+	TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+	Distribution->SetNumberField(TEXT("samples"), Values.Num());
+	Distribution->SetNumberField(TEXT("mean"), Values.Num() > 0 ? Sum / Values.Num() : 0.0);
+	Distribution->SetNumberField(TEXT("p50"), Percentile(Values, 0.50f));
+	Distribution->SetNumberField(TEXT("p90"), Percentile(Values, 0.90f));
+	Distribution->SetNumberField(TEXT("p95"), Percentile(Values, 0.95f));
+	Distribution->SetNumberField(TEXT("p99"), Percentile(Values, 0.99f));
+	Distribution->SetNumberField(TEXT("max"), Values.Num() > 0 ? Values.Last() : 0.0f);
+	return Distribution;
+}
+
+FString TopDownPerf::SaveReport(const TSharedRef<FJsonObject>& Report, const FString& SubDir, const FString& BaseName)
+{
+	// Tag every report with the build so results can be lined up across commits
+	Report->SetStringField(TEXT("build"), FEngineVersion::Current().ToString());
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString Path = FPaths::ProjectSavedDir() / SubDir / FString::Printf(TEXT("%s_%s.json"), *BaseName, *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write perf report %s"), *Path);
+		return FString();
+	}
+
+	return Path;
+}
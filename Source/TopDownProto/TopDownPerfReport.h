@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * TopDownPerf
+ *
+ * Shared helpers for the JSON reports written by the load test (ULoadTestSubsystem) and the
+ * perf suite (FTopDownPerfSuite), so both use the same percentile definition and layout.
+ */
+namespace TopDownPerf
+{
+	/** Nearest-rank percentile of an ascending array (0 if empty) */
+	TOPDOWNPROTO_API float Percentile(const TArray<float>& Sorted, float Fraction);
+
+	/** {samples, mean, p50, p90, p95, p99, max} of a series */
+	TOPDOWNPROTO_API TSharedRef<FJsonObject> MakeDistribution(TArray<float> Values);
+
+	/**
+	 * Write a report to Saved/<SubDir>/<BaseName>_<date>.json
+	 * @return Path of the written file (empty on failure)
+	 */
+	TOPDOWNPROTO_API FString SaveReport(const TSharedRef<FJsonObject>& Report, const FString& SubDir, const FString& BaseName);
+}
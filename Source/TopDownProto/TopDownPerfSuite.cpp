@@ -0,0 +1,370 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownPerfSuite.h"
+#include "TopDownPerfReport.h"
+#include "TopDownBotController.h"
+#include "TopDownCharacter.h"
+#include "TopDownGameMode.h"
+#include "TopDownHUD.h"
+#include "TopDownPlayerController.h"
+#include "WeaponComponent.h"
+#include "LoadTestSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/PlayerStart.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace TopDownPerfSuite
+{
+	constexpr float ArenaHalfExtent = 5000.0f;
+	constexpr int32 NumTryFireCalls = 500;
+	constexpr int32 NumFindPlayerStartCalls = 200;
+	constexpr int32 NumTakeDamageCalls = 1000;
+	constexpr int32 NumHUDFlushes = 1000;
+
+	/** Per-call log lines would dominate the numbers (and the log) */
+	struct FScopedQuietLog
+	{
+		FScopedQuietLog() : PreviousVerbosity(LogTemp.GetVerbosity()) { LogTemp.SetVerbosity(ELogVerbosity::Warning); }
+		~FScopedQuietLog() { LogTemp.SetVerbosity(PreviousVerbosity); }
+
+		ELogVerbosity::Type PreviousVerbosity;
+	};
+}
+
+float FTopDownPerfSuite::FResult::GetPercentile(float Fraction) const
+{
+	TArray<float> Sorted = SamplesUs;
+	Sorted.Sort();
+	return TopDownPerf::Percentile(Sorted, Fraction);
+}
+
+UWorld* FTopDownPerfSuite::FindGameWorld()
+{
+	if (!GEngine)
+	{
+		return nullptr;
+	}
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		if (World && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE)
+			&& World->GetNetMode() != NM_Client)
+		{
+			return World;
+		}
+	}
+	return nullptr;
+}
+
+FString FTopDownPerfSuite::WriteReport(UWorld* World, const FString& Name, const TArray<FResult>& Results)
+{
+	TArray<TSharedPtr<FJsonValue>> Benchmarks;
+	for (const FResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> Benchmark = TopDownPerf::MakeDistribution(Result.SamplesUs);
+		Benchmark->SetStringField(TEXT("name"), Result.Name);
+		Benchmark->SetStringField(TEXT("unit"), TEXT("us"));
+		Benchmarks.Add(MakeShared<FJsonValueObject>(Benchmark));
+
+		UE_LOG(LogTemp, Log, TEXT("Perf %-40s p50 %9.3f us  p95 %9.3f us  p99 %9.3f us  (%d calls)"),
+		       *Result.Name, Result.GetPercentile(0.50f), Result.GetPercentile(0.95f), Result.GetPercentile(0.99f),
+		       Result.SamplesUs.Num());
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("suite"), FString::Printf(TEXT("TopDownProto.Perf.%s"), *Name));
+	Report->SetStringField(TEXT("map"), World ? World->GetMapName() : FString());
+	Report->SetArrayField(TEXT("benchmarks"), Benchmarks);
+
+	const FString Path = TopDownPerf::SaveReport(Report, TEXT("Perf"), FString::Printf(TEXT("TopDownPerf_%s"), *Name));
+	UE_LOG(LogTemp, Log, TEXT("Perf %s: %d benchmarks -> %s"), *Name, Results.Num(), *Path);
+	return Path;
+}
+
+void FTopDownPerfSuite::SpawnCharacters(UWorld* World, int32 Count, FRandomStream& Random, TArray<ATopDownCharacter*>& OutCharacters)
+{
+	// Measure the shipped pawn (its Blueprint sets the projectile class) when the game mode has one
+	TSubclassOf<ATopDownCharacter> CharacterClass = ATopDownCharacter::StaticClass();
+	if (const AGameModeBase* GameMode = World->GetAuthGameMode())
+	{
+		if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(ATopDownCharacter::StaticClass()))
+		{
+			CharacterClass = GameMode->DefaultPawnClass.Get();
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Location(Random.FRandRange(-TopDownPerfSuite::ArenaHalfExtent, TopDownPerfSuite::ArenaHalfExtent),
+		                       Random.FRandRange(-TopDownPerfSuite::ArenaHalfExtent, TopDownPerfSuite::ArenaHalfExtent), 100.0f);
+		if (ATopDownCharacter* Character = World->SpawnActor<ATopDownCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParams))
+		{
+			OutCharacters.Add(Character);
+		}
+	}
+}
+
+// ========================================================================================
+// Micro-benchmarks
+// ========================================================================================
+
+void FTopDownPerfSuite::BenchTryFire(UWorld* World, TArray<FResult>& OutResults)
+{
+	const TopDownPerfSuite::FScopedQuietLog QuietLog;
+
+	FRandomStream Random(12345);
+	TArray<ATopDownCharacter*> Characters;
+	SpawnCharacters(World, 1, Random, Characters);
+
+	UWeaponComponent* Weapon = Characters.Num() > 0 ? Characters[0]->GetWeaponComponent() : nullptr;
+	if (Weapon)
+	{
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = TEXT("TryFire");
+		Result.SamplesUs.Reserve(TopDownPerfSuite::NumTryFireCalls);
+
+		for (int32 Call = 0; Call < TopDownPerfSuite::NumTryFireCalls; ++Call)
+		{
+			// Full magazine and no cooldown, so every call takes the firing path (not timed)
+			Weapon->ResetAmmo();
+			const FVector Direction = FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f).Vector();
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Weapon->TryFire(Direction);
+			Result.SamplesUs.Add(CyclesToUs(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+	for (ATopDownCharacter* Character : Characters)
+	{
+		Character->Destroy();
+	}
+}
+
+void FTopDownPerfSuite::BenchFindPlayerStart(UWorld* World, int32 NumStarts, int32 NumPlayers, TArray<FResult>& OutResults)
+{
+	ATopDownGameMode* GameMode = World->GetAuthGameMode<ATopDownGameMode>();
+	if (!GameMode)
+	{
+		return;
+	}
+
+	const TopDownPerfSuite::FScopedQuietLog QuietLog;
+
+	// The live match keeps its starts, claims and scores; the benchmark works on a synthetic set
+	TArray<FTopDownSpawnPoint> SavedSpawnPoints = MoveTemp(GameMode->SpawnPoints);
+	TArray<int32> SavedSpawnPointOrder = MoveTemp(GameMode->SpawnPointOrder);
+	const int32 SavedSpawnPointCursor = GameMode->SpawnPointCursor;
+	const uint64 SavedSpawnScoreFrame = GameMode->SpawnScoreFrame;
+
+	FRandomStream Random(NumStarts * 1000 + NumPlayers);
+
+	TArray<APlayerStart*> Starts;
+	GameMode->SpawnPoints.Reset();
+	for (int32 Index = 0; Index < NumStarts; ++Index)
+	{
+		const FVector Location(Random.FRandRange(-TopDownPerfSuite::ArenaHalfExtent, TopDownPerfSuite::ArenaHalfExtent),
+		                       Random.FRandRange(-TopDownPerfSuite::ArenaHalfExtent, TopDownPerfSuite::ArenaHalfExtent), 100.0f);
+		if (APlayerStart* Start = World->SpawnActor<APlayerStart>(APlayerStart::StaticClass(), Location, FRotator::ZeroRotator))
+		{
+			Starts.Add(Start);
+			FTopDownSpawnPoint& SpawnPoint = GameMode->SpawnPoints.AddDefaulted_GetRef();
+			SpawnPoint.Start = Start;
+			SpawnPoint.Location = Location;
+		}
+	}
+	GameMode->SpawnPointOrder.Reset();
+
+	TArray<ATopDownCharacter*> Characters;
+	SpawnCharacters(World, NumPlayers, Random, Characters);
+
+	// Cold: first respawn of a frame, pays for scoring every start
+	// Warm: later respawns in the same frame, only walk the sorted order
+	for (const bool bCold : { true, false })
+	{
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = FString::Printf(TEXT("FindPlayerStart.%s.%dStarts.%dPlayers"), bCold ? TEXT("Cold") : TEXT("Warm"), NumStarts, NumPlayers);
+		Result.SamplesUs.Reserve(TopDownPerfSuite::NumFindPlayerStartCalls);
+
+		for (int32 Call = 0; Call < TopDownPerfSuite::NumFindPlayerStartCalls; ++Call)
+		{
+			for (FTopDownSpawnPoint& SpawnPoint : GameMode->SpawnPoints)
+			{
+				SpawnPoint.ClaimedUntil = 0.0f;
+			}
+			GameMode->SpawnPointCursor = 0;
+			if (bCold)
+			{
+				GameMode->SpawnScoreFrame = 0;
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			GameMode->FindPlayerStart(nullptr);
+			Result.SamplesUs.Add(CyclesToUs(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+	for (ATopDownCharacter* Character : Characters)
+	{
+		Character->Destroy();
+	}
+	for (APlayerStart* Start : Starts)
+	{
+		Start->Destroy();
+	}
+
+	// Back to the match's own index, claims included
+	GameMode->SpawnPoints = MoveTemp(SavedSpawnPoints);
+	GameMode->SpawnPointOrder = MoveTemp(SavedSpawnPointOrder);
+	GameMode->SpawnPointCursor = SavedSpawnPointCursor;
+	GameMode->SpawnScoreFrame = SavedSpawnScoreFrame;
+}
+
+void FTopDownPerfSuite::BenchTakeDamage(UWorld* World, TArray<FResult>& OutResults)
+{
+	const TopDownPerfSuite::FScopedQuietLog QuietLog;
+
+	FRandomStream Random(54321);
+	TArray<ATopDownCharacter*> Characters;
+	SpawnCharacters(World, 2, Random, Characters);
+
+	if (Characters.Num() == 2)
+	{
+		ATopDownCharacter* Victim = Characters[0];
+		ATopDownCharacter* Shooter = Characters[1];
+		constexpr float DamagePerHit = 1.0f;
+
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = TEXT("TakeDamage");
+		Result.SamplesUs.Reserve(TopDownPerfSuite::NumTakeDamageCalls);
+
+		for (int32 Call = 0; Call < TopDownPerfSuite::NumTakeDamageCalls; ++Call)
+		{
+			// Stay alive so every call takes the damage path, not the death path (not timed)
+			if (Victim->GetHealth() <= DamagePerHit * 2.0f)
+			{
+				Victim->ResetForRespawn();
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			UGameplayStatics::ApplyDamage(Victim, DamagePerHit, nullptr, Shooter, UDamageType::StaticClass());
+			Result.SamplesUs.Add(CyclesToUs(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+	for (ATopDownCharacter* Character : Characters)
+	{
+		Character->Destroy();
+	}
+}
+
+bool FTopDownPerfSuite::BenchHUDFlush(UWorld* World, TArray<FResult>& OutResults)
+{
+	if (IsRunningDedicatedServer())
+	{
+		return false;
+	}
+
+	const TopDownPerfSuite::FScopedQuietLog QuietLog;
+
+	// The Blueprint HUD from the player controller when there is one (that's where the redraw cost is)
+	TSubclassOf<UTopDownHUD> HUDClass = UTopDownHUD::StaticClass();
+	if (const ATopDownPlayerController* PC = Cast<ATopDownPlayerController>(World->GetFirstPlayerController()))
+	{
+		if (PC->HUDWidgetClass)
+		{
+			HUDClass = PC->HUDWidgetClass;
+		}
+	}
+
+	FRandomStream Random(999);
+	TArray<ATopDownCharacter*> Characters;
+	SpawnCharacters(World, 1, Random, Characters);
+
+	// Never added to the viewport, so the end-of-frame hook is not registered and only this loop flushes
+	UTopDownHUD* HUD = Characters.Num() > 0 ? CreateWidget<UTopDownHUD>(World, HUDClass) : nullptr;
+	if (HUD)
+	{
+		ATopDownCharacter* Character = Characters[0];
+		HUD->InitializeHUD(Character);
+		constexpr float DamagePerHit = 1.0f;
+
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = TEXT("HUDFlush");
+		Result.SamplesUs.Reserve(TopDownPerfSuite::NumHUDFlushes);
+
+		for (int32 Call = 0; Call < TopDownPerfSuite::NumHUDFlushes; ++Call)
+		{
+			// A hit this frame, so the flush has a changed value to show (not timed)
+			if (Character->GetHealth() <= DamagePerHit * 2.0f)
+			{
+				Character->ResetForRespawn();
+			}
+			UGameplayStatics::ApplyDamage(Character, DamagePerHit, nullptr, nullptr, UDamageType::StaticClass());
+
+			// A typical frame: several replicated changes mark fields, one flush redraws what changed
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			HUD->MarkDirty(EHUDDirtyFlags::Health);
+			HUD->MarkDirty(EHUDDirtyFlags::Ammo | EHUDDirtyFlags::Reserve);
+			HUD->MarkDirty(EHUDDirtyFlags::Health);
+			HUD->FlushDirtyFields();
+			Result.SamplesUs.Add(CyclesToUs(FPlatformTime::Cycles64() - StartCycles));
+		}
+
+		HUD->RemoveFromParent();
+	}
+
+	for (ATopDownCharacter* Character : Characters)
+	{
+		Character->Destroy();
+	}
+	return true;
+}
+
+// ========================================================================================
+// Scenario
+// ========================================================================================
+
+TArray<ATopDownBotController*> FTopDownPerfSuite::StartScenario(UWorld* World, int32 NumCharacters, float Seconds)
+{
+	ATopDownGameMode* GameMode = World ? World->GetAuthGameMode<ATopDownGameMode>() : nullptr;
+	ULoadTestSubsystem* LoadTest = World ? World->GetSubsystem<ULoadTestSubsystem>() : nullptr;
+	if (!GameMode || !LoadTest || NumCharacters <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Perf scenario needs a TopDown game mode with authority and a character count"));
+		return TArray<ATopDownBotController*>();
+	}
+
+	// Every bot holds the trigger for the whole run, target in range or not
+	TArray<ATopDownBotController*> Bots = GameMode->SpawnBots(NumCharacters);
+	for (ATopDownBotController* Bot : Bots)
+	{
+		Bot->SetFireContinuously(true);
+	}
+
+	LoadTest->StartLoadTest(Bots.Num(), Seconds);
+	return Bots;
+}
+
+void FTopDownPerfSuite::StopScenario(TConstArrayView<TWeakObjectPtr<ATopDownBotController>> Bots)
+{
+	for (const TWeakObjectPtr<ATopDownBotController>& WeakBot : Bots)
+	{
+		if (ATopDownBotController* Bot = WeakBot.Get())
+		{
+			if (APawn* Pawn = Bot->GetPawn())
+			{
+				Pawn->Destroy();
+			}
+			Bot->Destroy();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ATopDownCharacter;
+class ATopDownBotController;
+
+/**
+ * FTopDownPerfSuite
+ *
+ * Gameplay performance benchmarks behind the TopDownProto.Perf automation tests (TopDownPerfTests.cpp).
+ * They run in a live game world, so they can be driven headless on the dedicated server:
+ *   TopDownProtoServer Arena -log -ExecCmds="Automation RunTests TopDownProto.Perf; quit"
+ *
+ * Features:
+ * - Micro-benchmarks: TryFire, FindPlayerStart (N starts x M players, cold and warm frame),
+ *   TakeDamage and the HUD dirty-field flush (skipped on dedicated servers, which cannot create widgets)
+ * - Scenario: N bots holding the trigger for S seconds, measured by ULoadTestSubsystem
+ * - Every benchmark records per-call samples; the JSON in Saved/Perf/ has p50/p90/p95/p99
+ *   in microseconds and is tagged with the build so results can be compared across commits
+ * - Benchmarks leave the world as they found it (spawned actors destroyed, spawn point index restored)
+ */
+class TOPDOWNPROTO_API FTopDownPerfSuite
+{
+public:
+	/** Per-call samples of one benchmark */
+	struct FResult
+	{
+		FString Name;
+		TArray<float> SamplesUs;
+
+		/** Nearest-rank percentile of the samples in microseconds */
+		float GetPercentile(float Fraction) const;
+	};
+
+	/** Game or PIE world with authority to benchmark in, or null if none is running */
+	static UWorld* FindGameWorld();
+
+	// ========================================================================================
+	// Micro-benchmarks (authority only; each appends its results)
+	// ========================================================================================
+
+	static void BenchTryFire(UWorld* World, TArray<FResult>& OutResults);
+	static void BenchFindPlayerStart(UWorld* World, int32 NumStarts, int32 NumPlayers, TArray<FResult>& OutResults);
+	static void BenchTakeDamage(UWorld* World, TArray<FResult>& OutResults);
+
+	/** @return False if skipped (widgets cannot be created on a dedicated server) */
+	static bool BenchHUDFlush(UWorld* World, TArray<FResult>& OutResults);
+
+	/**
+	 * Log the results and write Saved/Perf/TopDownPerf_<Name>_<date>.json
+	 * @return Path of the written file (empty on failure)
+	 */
+	static FString WriteReport(UWorld* World, const FString& Name, const TArray<FResult>& Results);
+
+	// ========================================================================================
+	// Scenario
+	// ========================================================================================
+
+	/**
+	 * Spawn bots that fire continuously and start measuring the server for a fixed time
+	 * @param World - Game world to run in
+	 * @param NumCharacters - Bots to spawn
+	 * @param Seconds - Measured seconds after the load test warmup
+	 * @return Bots spawned (empty without a TopDown game mode with authority)
+	 */
+	static TArray<ATopDownBotController*> StartScenario(UWorld* World, int32 NumCharacters, float Seconds);
+
+	/** Remove the scenario's bots and their characters */
+	static void StopScenario(TConstArrayView<TWeakObjectPtr<ATopDownBotController>> Bots);
+
+private:
+	/** Spawn benchmark characters of the game mode's pawn class scattered across the arena */
+	static void SpawnCharacters(UWorld* World, int32 Count, FRandomStream& Random, TArray<ATopDownCharacter*>& OutCharacters);
+
+	/** Convert a cycle count to microseconds */
+	static float CyclesToUs(uint64 Cycles) { return static_cast<float>(FPlatformTime::ToSeconds64(Cycles) * 1000000.0); }
+};
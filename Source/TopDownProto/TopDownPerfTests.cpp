@@ -0,0 +1,288 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownPerfSuite.h"
+#include "TopDownBotController.h"
+#include "LoadTestSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * TopDownProto.Perf automation tests
+ *
+ * Run in a live game world (the running game, PIE, or the dedicated server):
+ *   TopDownProtoServer Arena -log -ExecCmds="Automation RunTests TopDownProto.Perf; quit"
+ * Each test writes its JSON report (see FTopDownPerfSuite) and fails when its p95 is over budget.
+ */
+
+static TAutoConsoleVariable<float> CVarTopDownPerfBudgetScale(
+	TEXT("TopDown.Perf.BudgetScale"),
+	1.0f,
+	TEXT("Multiplier on the TopDownProto.Perf test budgets (raise it on slow or shared build machines)"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarTopDownPerfScenarioSeconds(
+	TEXT("TopDown.Perf.ScenarioSeconds"),
+	60.0f,
+	TEXT("Measured seconds of each TopDownProto.Perf.Scenario test (after the load test warmup)"),
+	ECVF_Default
+);
+
+namespace TopDownPerfTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+	/** p95 budgets per call, in microseconds */
+	constexpr float TryFireBudgetUs = 250.0f;
+	constexpr float FindPlayerStartColdBudgetUs = 1000.0f;
+	constexpr float FindPlayerStartWarmBudgetUs = 50.0f;
+	constexpr float TakeDamageBudgetUs = 50.0f;
+	constexpr float HUDFlushBudgetUs = 200.0f;
+
+	/** Scenario p95 game thread budget: one 30 Hz server tick */
+	constexpr float ScenarioGameThreadBudgetMs = 1000.0f / 30.0f;
+
+	float ScaleBudget(float Budget)
+	{
+		return Budget * FMath::Max(CVarTopDownPerfBudgetScale.GetValueOnGameThread(), 0.0f);
+	}
+
+	UWorld* GetWorldOrError(FAutomationTestBase& Test)
+	{
+		UWorld* World = FTopDownPerfSuite::FindGameWorld();
+		if (!World)
+		{
+			Test.AddError(TEXT("TopDownProto.Perf needs a running game world with authority (load a map first)"));
+		}
+		return World;
+	}
+
+	/** Fail the test if the benchmark has no samples or its p95 is over the (scaled) budget */
+	void CheckBudget(FAutomationTestBase& Test, const FTopDownPerfSuite::FResult& Result, float BudgetUs)
+	{
+		if (Result.SamplesUs.Num() == 0)
+		{
+			Test.AddError(FString::Printf(TEXT("%s recorded no samples"), *Result.Name));
+			return;
+		}
+
+		const float P95Us = Result.GetPercentile(0.95f);
+		const float ScaledBudgetUs = ScaleBudget(BudgetUs);
+		if (P95Us > ScaledBudgetUs)
+		{
+			Test.AddError(FString::Printf(TEXT("%s p95 %.3f us is over its %.3f us budget"), *Result.Name, P95Us, ScaledBudgetUs));
+		}
+		else
+		{
+			Test.AddInfo(FString::Printf(TEXT("%s p95 %.3f us (budget %.3f us)"), *Result.Name, P95Us, ScaledBudgetUs));
+		}
+	}
+
+	/** Check every result of a single-benchmark test, failing if it produced none */
+	bool CheckResults(FAutomationTestBase& Test, const TArray<FTopDownPerfSuite::FResult>& Results, float BudgetUs)
+	{
+		if (Results.Num() == 0)
+		{
+			Test.AddError(TEXT("Benchmark could not run in this world"));
+		}
+		for (const FTopDownPerfSuite::FResult& Result : Results)
+		{
+			CheckBudget(Test, Result, BudgetUs);
+		}
+		return !Test.HasAnyErrors();
+	}
+}
+
+// ========================================================================================
+// Micro-benchmarks
+// ========================================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTopDownPerfTryFireTest, "TopDownProto.Perf.TryFire", TopDownPerfTests::TestFlags)
+
+bool FTopDownPerfTryFireTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = TopDownPerfTests::GetWorldOrError(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	TArray<FTopDownPerfSuite::FResult> Results;
+	FTopDownPerfSuite::BenchTryFire(World, Results);
+	FTopDownPerfSuite::WriteReport(World, TEXT("TryFire"), Results);
+	return TopDownPerfTests::CheckResults(*this, Results, TopDownPerfTests::TryFireBudgetUs);
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FTopDownPerfFindPlayerStartTest, "TopDownProto.Perf.FindPlayerStart", TopDownPerfTests::TestFlags)
+
+void FTopDownPerfFindPlayerStartTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	// N starts x M players
+	for (const int32 NumStarts : { 16, 64, 256 })
+	{
+		for (const int32 NumPlayers : { 16, 64 })
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%dStarts.%dPlayers"), NumStarts, NumPlayers));
+			OutTestCommands.Add(FString::Printf(TEXT("%d %d"), NumStarts, NumPlayers));
+		}
+	}
+}
+
+bool FTopDownPerfFindPlayerStartTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = TopDownPerfTests::GetWorldOrError(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	FString StartsArg;
+	FString PlayersArg;
+	Parameters.Split(TEXT(" "), &StartsArg, &PlayersArg);
+	const int32 NumStarts = FCString::Atoi(*StartsArg);
+	const int32 NumPlayers = FCString::Atoi(*PlayersArg);
+
+	TArray<FTopDownPerfSuite::FResult> Results;
+	FTopDownPerfSuite::BenchFindPlayerStart(World, NumStarts, NumPlayers, Results);
+	FTopDownPerfSuite::WriteReport(World, FString::Printf(TEXT("FindPlayerStart_%dStarts_%dPlayers"), NumStarts, NumPlayers), Results);
+
+	if (Results.Num() == 0)
+	{
+		AddError(TEXT("FindPlayerStart needs a TopDown game mode with authority"));
+	}
+	for (const FTopDownPerfSuite::FResult& Result : Results)
+	{
+		const bool bCold = Result.Name.Contains(TEXT(".Cold."));
+		TopDownPerfTests::CheckBudget(*this, Result, bCold ? TopDownPerfTests::FindPlayerStartColdBudgetUs : TopDownPerfTests::FindPlayerStartWarmBudgetUs);
+	}
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTopDownPerfTakeDamageTest, "TopDownProto.Perf.TakeDamage", TopDownPerfTests::TestFlags)
+
+bool FTopDownPerfTakeDamageTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = TopDownPerfTests::GetWorldOrError(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	TArray<FTopDownPerfSuite::FResult> Results;
+	FTopDownPerfSuite::BenchTakeDamage(World, Results);
+	FTopDownPerfSuite::WriteReport(World, TEXT("TakeDamage"), Results);
+	return TopDownPerfTests::CheckResults(*this, Results, TopDownPerfTests::TakeDamageBudgetUs);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTopDownPerfHUDFlushTest, "TopDownProto.Perf.HUDFlush", TopDownPerfTests::TestFlags)
+
+bool FTopDownPerfHUDFlushTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = TopDownPerfTests::GetWorldOrError(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	TArray<FTopDownPerfSuite::FResult> Results;
+	if (!FTopDownPerfSuite::BenchHUDFlush(World, Results))
+	{
+		AddInfo(TEXT("HUDFlush skipped: widgets cannot be created on a dedicated server"));
+		return true;
+	}
+
+	FTopDownPerfSuite::WriteReport(World, TEXT("HUDFlush"), Results);
+	return TopDownPerfTests::CheckResults(*this, Results, TopDownPerfTests::HUDFlushBudgetUs);
+}
+
+// ========================================================================================
+// Scenario
+// ========================================================================================
+
+/**
+ * Waits for the scenario's load test to finish (it writes its own JSON report),
+ * then checks the game thread budget and removes the bots
+ */
+class FTopDownPerfScenarioCommand : public IAutomationLatentCommand
+{
+public:
+	FTopDownPerfScenarioCommand(FAutomationTestBase* InTest, UWorld* InWorld, TArray<TWeakObjectPtr<ATopDownBotController>>&& InBots)
+		: Test(InTest)
+		, World(InWorld)
+		, Bots(MoveTemp(InBots))
+	{
+	}
+
+	virtual bool Update() override
+	{
+		const ULoadTestSubsystem* LoadTest = World.IsValid() ? World->GetSubsystem<ULoadTestSubsystem>() : nullptr;
+		if (LoadTest && LoadTest->IsRunning())
+		{
+			return false;
+		}
+
+		if (!LoadTest || LoadTest->GetNumMeasuredFrames() == 0)
+		{
+			Test->AddError(TEXT("Scenario ended without measuring any frames (world torn down?)"));
+		}
+		else
+		{
+			const float P95Ms = LoadTest->GetGameThreadTimePercentile(0.95f);
+			const float BudgetMs = TopDownPerfTests::ScaleBudget(TopDownPerfTests::ScenarioGameThreadBudgetMs);
+			if (P95Ms > BudgetMs)
+			{
+				Test->AddError(FString::Printf(TEXT("Scenario game thread p95 %.2f ms is over its %.2f ms budget"), P95Ms, BudgetMs));
+			}
+			else
+			{
+				Test->AddInfo(FString::Printf(TEXT("Scenario game thread p95 %.2f ms (budget %.2f ms)"), P95Ms, BudgetMs));
+			}
+		}
+
+		FTopDownPerfSuite::StopScenario(Bots);
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	TWeakObjectPtr<UWorld> World;
+	TArray<TWeakObjectPtr<ATopDownBotController>> Bots;
+};
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FTopDownPerfScenarioTest, "TopDownProto.Perf.Scenario", TopDownPerfTests::TestFlags)
+
+void FTopDownPerfScenarioTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 NumCharacters : { 16, 32, 64 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%dCharacters"), NumCharacters));
+		OutTestCommands.Add(FString::FromInt(NumCharacters));
+	}
+}
+
+bool FTopDownPerfScenarioTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = TopDownPerfTests::GetWorldOrError(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	// N characters firing continuously for the configured time (60 s by default)
+	const int32 NumCharacters = FCString::Atoi(*Parameters);
+	const TArray<ATopDownBotController*> Bots = FTopDownPerfSuite::StartScenario(World, NumCharacters, CVarTopDownPerfScenarioSeconds.GetValueOnGameThread());
+	if (Bots.Num() == 0)
+	{
+		AddError(TEXT("Scenario needs a TopDown game mode with authority and a bot controller class"));
+		return false;
+	}
+
+	TArray<TWeakObjectPtr<ATopDownBotController>> WeakBots(Bots);
+	ADD_LATENT_AUTOMATION_COMMAND(FTopDownPerfScenarioCommand(this, World, MoveTemp(WeakBots)));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
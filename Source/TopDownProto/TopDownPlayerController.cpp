@@ -45,6 +45,14 @@ void ATopDownPlayerController::OnRep_Pawn()
 	       GetPawn() ? *GetPawn()->GetName() : TEXT("None"));
 }
 
+void ATopDownPlayerController::ClientReceiveCosmeticEvents_Implementation(const TArray<FCosmeticEvent>& Events)
+{
+	for (const FCosmeticEvent& Event : Events)
+	{
+		UCosmeticEventSubsystem::PlayEvent(GetWorld(), Event);
+	}
+}
+
 void ATopDownPlayerController::CreateHUD()
 {
 	if (HUDWidgetClass && !HUDWidget)
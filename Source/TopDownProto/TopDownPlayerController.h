@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "CosmeticEventSubsystem.h"
 #include "TopDownPlayerController.generated.h"
 
 class UTopDownHUD;
@@ -42,6 +43,18 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "UI")
 	UTopDownHUD* HUDWidget;
 
+	// ========================================================================================
+	// Cosmetic Events
+	// ========================================================================================
+
+	/**
+	 * Client RPC - This frame's muzzle/impact events near our view, batched by UCosmeticEventSubsystem
+	 * @param Events - Events to play locally
+	 */
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveCosmeticEvents(const TArray<FCosmeticEvent>& Events);
+	void ClientReceiveCosmeticEvents_Implementation(const TArray<FCosmeticEvent>& Events);
+
 protected:
 
 	/** Create HUD widget */
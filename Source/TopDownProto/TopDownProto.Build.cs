@@ -15,7 +15,8 @@ public class TopDownProto : ModuleRules
 			"Engine", 
 			"InputCore", 
 			"EnhancedInput",
-			"HeadMountedDisplay"  // For VR support if needed
+			"HeadMountedDisplay",  // For VR support if needed
+			"ReplicationGraph"     // TopDownReplicationGraph derives from UReplicationGraph
 		});
 
 		// Networking and multiplayer modules
@@ -23,7 +24,8 @@ public class TopDownProto : ModuleRules
 			"OnlineSubsystem",
 			"OnlineSubsystemUtils",
 			"Sockets",
-			"Networking"
+			"Networking",
+			"NetCore"     // Push model replication
 		});
 
 		// UI modules
@@ -38,5 +40,10 @@ public class TopDownProto : ModuleRules
 			"AIModule",
 			"GameplayTasks"
 		});
+
+		// Load test and benchmark reports
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Json"
+		});
 	}
 }
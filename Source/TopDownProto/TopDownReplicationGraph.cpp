@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownReplicationGraph.h"
+#include "TopDownCharacter.h"
+#include "Projectile.h"
+#include "ReplicationGraphTypes.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameFramework/Info.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetDriver.h"
+
+float UTopDownReplicationGraph::GetViewFootprintRadius(const UWorld* World) const
+{
+	if (ViewFootprintRadiusOverride > 0.0f)
+	{
+		return ViewFootprintRadiusOverride;
+	}
+
+	// Blueprint pawns can change the boom and FOV, so read the pawn class the game mode actually spawns
+	const ATopDownCharacter* CharacterCDO = GetDefault<ATopDownCharacter>();
+	const UClass* GameModeClass = nullptr;
+	if (World)
+	{
+		if (const AGameModeBase* GameMode = World->GetAuthGameMode())
+		{
+			GameModeClass = GameMode->GetClass();
+		}
+		else if (const AGameStateBase* GameState = World->GetGameState())
+		{
+			GameModeClass = GameState->GameModeClass;
+		}
+		else if (const AWorldSettings* WorldSettings = World->GetWorldSettings())
+		{
+			GameModeClass = WorldSettings->DefaultGameMode;
+		}
+	}
+	if (GameModeClass)
+	{
+		const UClass* PawnClass = GameModeClass->GetDefaultObject<AGameModeBase>()->DefaultPawnClass;
+		if (PawnClass && PawnClass->IsChildOf(ATopDownCharacter::StaticClass()))
+		{
+			CharacterCDO = PawnClass->GetDefaultObject<ATopDownCharacter>();
+		}
+	}
+
+	const USpringArmComponent* Boom = CharacterCDO->GetCameraBoom();
+	const UCameraComponent* Camera = CharacterCDO->GetTopDownCameraComponent();
+
+	const float ArmLength = Boom ? Boom->TargetArmLength : 800.0f;
+	const float Pitch = FMath::DegreesToRadians(Boom ? FMath::Abs(Boom->GetRelativeRotation().Pitch) : 60.0f);
+	const float HalfHorizontalFOV = FMath::DegreesToRadians((Camera ? Camera->FieldOfView : 90.0f) * 0.5f);
+	const float HalfVerticalFOV = FMath::Atan(FMath::Tan(HalfHorizontalFOV) / FMath::Max(ViewAspectRatio, UE_KINDA_SMALL_NUMBER));
+
+	// Camera sits ArmLength behind and above the pawn; the far edge of the view hits the
+	// ground at (Pitch - HalfVerticalFOV) below the horizon
+	const float CameraHeight = ArmLength * FMath::Sin(Pitch);
+	const float CameraBack = ArmLength * FMath::Cos(Pitch);
+	const float FarAngle = FMath::Max(Pitch - HalfVerticalFOV, FMath::DegreesToRadians(10.0f));
+
+	const float FarDistance = CameraHeight / FMath::Tan(FarAngle) - CameraBack;
+	const float FarHalfWidth = (CameraHeight / FMath::Sin(FarAngle)) * FMath::Tan(HalfHorizontalFOV);
+
+	return FMath::Sqrt(FMath::Square(FarDistance) + FMath::Square(FarHalfWidth));
+}
+
+void UTopDownReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// ========================================================================================
+	// Routing
+	// ========================================================================================
+
+	ClassRepNodePolicies.Set(AReplicationGraphDebugActor::StaticClass(), ETopDownClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), ETopDownClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), ETopDownClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AInfo::StaticClass(), ETopDownClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(APawn::StaticClass(), ETopDownClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AProjectile::StaticClass(), ETopDownClassRepNodeMapping::Spatialize_Dynamic);
+
+	// ========================================================================================
+	// Cull distances and update rates for the spatialized classes
+	// ========================================================================================
+
+	const float FootprintRadius = GetViewFootprintRadius(GetWorld());
+	const float CullDistance = FootprintRadius * CullDistanceScale;
+
+	auto SetSpatialClassInfo = [this, CullDistance](UClass* Class)
+	{
+		const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.SetCullDistanceSquared(FMath::Square(CullDistance));
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->GetNetUpdateFrequency());
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	};
+	SetSpatialClassInfo(ATopDownCharacter::StaticClass());
+	SetSpatialClassInfo(AProjectile::StaticClass());
+
+	UE_LOG(LogTemp, Log, TEXT("TopDownReplicationGraph: camera footprint radius %.0f, cull distance %.0f, cell size %.0f"),
+	       FootprintRadius, CullDistance, FootprintRadius * CellSizeScale);
+}
+
+void UTopDownReplicationGraph::InitGlobalGraphNodes()
+{
+	// Spatialized actors - a connection only gathers the cells around its viewers
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = FMath::Max(GetViewFootprintRadius(GetWorld()) * CellSizeScale, 100.0f);
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	// Game state, player states, world settings
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UTopDownReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// The connection's own player controller and view target (its pawn), wherever they are
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(OwnerNode, RepGraphConnection);
+}
+
+ETopDownClassRepNodeMapping UTopDownReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	if (const ETopDownClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+
+	// Anything unclassified: always relevant actors stay always relevant, everything else goes in the grid
+	const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+	ETopDownClassRepNodeMapping Policy = ETopDownClassRepNodeMapping::Spatialize_Dynamic;
+	if (ActorCDO->bAlwaysRelevant)
+	{
+		Policy = ETopDownClassRepNodeMapping::RelevantAllConnections;
+	}
+	else if (!ActorCDO->GetRootComponent() || ActorCDO->GetRootComponent()->Mobility != EComponentMobility::Movable)
+	{
+		Policy = ETopDownClassRepNodeMapping::Spatialize_Static;
+	}
+
+	ClassRepNodePolicies.Set(Class, Policy);
+	return Policy;
+}
+
+void UTopDownReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ETopDownClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ETopDownClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case ETopDownClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ETopDownClassRepNodeMapping::NotRouted:
+		break;
+	}
+}
+
+void UTopDownReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ETopDownClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ETopDownClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case ETopDownClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ETopDownClassRepNodeMapping::NotRouted:
+		break;
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "TopDownReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+
+/**
+ * ETopDownClassRepNodeMapping
+ *
+ * How actors of a class are routed into the replication graph
+ */
+UENUM()
+enum class ETopDownClassRepNodeMapping : uint8
+{
+	NotRouted,                  // Handled elsewhere (player controllers, via the per-connection node)
+	RelevantAllConnections,     // Always relevant node (game state, player states, other AInfo)
+	Spatialize_Static,          // Grid, never moves
+	Spatialize_Dynamic,         // Grid, moves every frame (characters, projectiles)
+};
+
+/**
+ * UTopDownReplicationGraph
+ *
+ * Replication driver for the top-down shooter.
+ *
+ * Features:
+ * - 2D grid node for characters, projectiles and other spatial actors
+ * - Always relevant node for ATopDownGameState and player states
+ * - Per-connection node for the connection's own controller and view target, so owner-only
+ *   state (e.g. UWeaponComponent's COND_OwnerOnly OwnerState) always reaches its owner
+ * - Grid cell size and cull distance derived from the top-down camera footprint
+ *
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+ */
+UCLASS(transient, config=Engine)
+class TOPDOWNPROTO_API UTopDownReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UReplicationGraph Interface
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	//~ End UReplicationGraph Interface
+
+	/**
+	 * Radius of the ground area visible through the default top-down camera
+	 * Derived from the camera boom and FOV of the game mode's default pawn (ATopDownCharacter's
+	 * if that isn't a top-down character) unless ViewFootprintRadiusOverride is set
+	 * @param World - World whose game mode picks the pawn class (the server's game mode, or the replicated game mode class on clients)
+	 */
+	float GetViewFootprintRadius(const UWorld* World) const;
+
+protected:
+	// ========================================================================================
+	// Configuration (DefaultEngine.ini)
+	// ========================================================================================
+
+	/** Viewport aspect ratio used to derive the camera footprint */
+	UPROPERTY(Config)
+	float ViewAspectRatio = 16.0f / 9.0f;
+
+	/** Use this footprint radius instead of deriving it from the camera (0 = derive) */
+	UPROPERTY(Config)
+	float ViewFootprintRadiusOverride = 0.0f;
+
+	/** Spatialized actors further than FootprintRadius * CullDistanceScale from a viewer are not replicated to it */
+	UPROPERTY(Config)
+	float CullDistanceScale = 1.5f;
+
+	/** Grid cell size as a multiple of the footprint radius */
+	UPROPERTY(Config)
+	float CellSizeScale = 1.0f;
+
+	/** World-space offset so grid cells start at non-negative coordinates */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-100000.0f, -100000.0f);
+
+private:
+	/** Routing policy for a class (walks up the class hierarchy, falls back to dynamic spatialization) */
+	ETopDownClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	/** Class routing policies */
+	TClassMap<ETopDownClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** Grid node for spatialized actors */
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	/** Actors relevant to every connection */
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+};
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TopDownStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(TOPDOWNPROTO_API, TopDown, true);
+
+DEFINE_STAT(STAT_TopDownTryFire);
+DEFINE_STAT(STAT_TopDownFireWeapon);
+DEFINE_STAT(STAT_TopDownLaunchProjectile);
+DEFINE_STAT(STAT_TopDownProjectileOnHit);
+DEFINE_STAT(STAT_TopDownTakeDamage);
+DEFINE_STAT(STAT_TopDownDamageResolve);
+DEFINE_STAT(STAT_TopDownFindPlayerStart);
+DEFINE_STAT(STAT_TopDownScoreSpawnPoints);
+DEFINE_STAT(STAT_TopDownHandleRespawn);
+DEFINE_STAT(STAT_TopDownCharacterPreReplication);
+DEFINE_STAT(STAT_TopDownWeaponPreReplication);
+DEFINE_STAT(STAT_TopDownManagedProjectiles);
+DEFINE_STAT(STAT_TopDownLagCompensationRecord);
+DEFINE_STAT(STAT_TopDownLagCompensationRewind);
+DEFINE_STAT(STAT_TopDownSpatialGridUpdate);
+DEFINE_STAT(STAT_TopDownCosmeticEventFlush);
+
+DEFINE_STAT(STAT_TopDownShotsFired);
+DEFINE_STAT(STAT_TopDownProjectilesAlive);
+DEFINE_STAT(STAT_TopDownManagedProjectilesEvicted);
+DEFINE_STAT(STAT_TopDownHits);
+DEFINE_STAT(STAT_TopDownDamageEvents);
+DEFINE_STAT(STAT_TopDownDamageVictims);
+DEFINE_STAT(STAT_TopDownHUDUpdates);
+DEFINE_STAT(STAT_TopDownHUDEvents);
+DEFINE_STAT(STAT_TopDownRPCsReceived);
+
+
+DEFINE_STAT(STAT_TopDownPushModelDirtyMarks);
+DEFINE_STAT(STAT_TopDownPushModelComparesSkipped);
+DEFINE_STAT(STAT_TopDownAimYawSent);
+DEFINE_STAT(STAT_TopDownAimYawSkipped);
+DEFINE_STAT(STAT_TopDownFlatFloorChecks);
+DEFINE_STAT(STAT_TopDownDistantProxyTicks);
+DEFINE_STAT(STAT_TopDownCharacterTicks);
+DEFINE_STAT(STAT_TopDownReloadTimersFired);
+DEFINE_STAT(STAT_TopDownRespawnQueueDepth);
+DEFINE_STAT(STAT_TopDownRespawns);
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * TopDown stat group ("stat TopDown") and CSV category ("-csvprofile", category TopDown)
+ *
+ * Game-specific counters and timers. Stats are defined in TopDownStats.cpp.
+ * Hot paths use TOPDOWN_SCOPE_CYCLE_COUNTER, which feeds the stat group, Insights (CPU channel)
+ * and the CSV profiler from a single name; gameplay counters use TOPDOWN_INC_COUNTER/TOPDOWN_SET_COUNTER.
+ */
+DECLARE_STATS_GROUP(TEXT("TopDown"), STATGROUP_TopDown, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TOPDOWNPROTO_API, TopDown);
+
+/** Time the enclosing scope as STAT_TopDown<Name>, Insights event TopDown_<Name> and CSV stat TopDown/<Name> */
+#define TOPDOWN_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_TopDown##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(TopDown_##Name); \
+	CSV_SCOPED_TIMING_STAT(TopDown, Name)
+
+/** Add to the per-frame counter STAT_TopDown<Name> and CSV stat TopDown/<Name> (a single statement) */
+#define TOPDOWN_INC_COUNTER(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_TopDown##Name, Amount); \
+		CSV_CUSTOM_STAT(TopDown, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+
+/** Set the gauge STAT_TopDown<Name> and CSV stat TopDown/<Name> (a single statement) */
+#define TOPDOWN_SET_COUNTER(Name, Value) \
+	do \
+	{ \
+		SET_DWORD_STAT(STAT_TopDown##Name, Value); \
+		CSV_CUSTOM_STAT(TopDown, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set); \
+	} while (0)
+
+// ========================================================================================
+// Hot Path Timers
+// ========================================================================================
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryFire"), STAT_TopDownTryFire, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FireWeapon"), STAT_TopDownFireWeapon, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LaunchProjectile"), STAT_TopDownLaunchProjectile, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile OnHit"), STAT_TopDownProjectileOnHit, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TakeDamage"), STAT_TopDownTakeDamage, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Resolve"), STAT_TopDownDamageResolve, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindPlayerStart"), STAT_TopDownFindPlayerStart, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Score Spawn Points"), STAT_TopDownScoreSpawnPoints, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HandleRespawn"), STAT_TopDownHandleRespawn, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character PreReplication"), STAT_TopDownCharacterPreReplication, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon PreReplication"), STAT_TopDownWeaponPreReplication, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Managed Projectiles Tick"), STAT_TopDownManagedProjectiles, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lag Compensation Record"), STAT_TopDownLagCompensationRecord, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lag Compensation Rewind"), STAT_TopDownLagCompensationRewind, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Grid Update"), STAT_TopDownSpatialGridUpdate, STATGROUP_TopDown, TOPDOWNPROTO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cosmetic Event Flush"), STAT_TopDownCosmeticEventFlush, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+// ========================================================================================
+// Gameplay Counters
+// ========================================================================================
+
+/** Shots that passed TryFire this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shots Fired"), STAT_TopDownShotsFired, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Projectile actors handed out by the pool plus managed projectiles in flight */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectiles Alive"), STAT_TopDownProjectilesAlive, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Managed projectiles removed early this frame to make room for new shots (UManagedProjectileSubsystem at MaxProjectiles) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Managed Projectiles Evicted"), STAT_TopDownManagedProjectilesEvicted, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Projectile hits on actors this frame (actor, managed and lag-compensated projectiles) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits"), STAT_TopDownHits, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Hits taken by characters this frame (direct TakeDamage calls and aggregated contributions) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events"), STAT_TopDownDamageEvents, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Victims resolved by UDamageAggregationSubsystem this frame (one health change each) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Victims"), STAT_TopDownDamageVictims, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** HUD redraws this frame (coalesced dirty-field flushes and forced full updates) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("HUD Updates"), STAT_TopDownHUDUpdates, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** HUD Blueprint events fired this frame (only for fields whose values changed) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("HUD Events"), STAT_TopDownHUDEvents, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Server RPCs received this frame (gameplay RPCs and packed ServerMoves) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPCs Received"), STAT_TopDownRPCsReceived, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+// ========================================================================================
+// Replication
+// ========================================================================================
+
+/** Push-model properties marked dirty this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Push Model Dirty Marks"), STAT_TopDownPushModelDirtyMarks, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Push-model properties that were clean at PreReplication this frame (property compares the net driver skipped) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Push Model Compares Skipped"), STAT_TopDownPushModelComparesSkipped, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Saved moves that carried the aim yaw to the server (client) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aim Yaw Sent"), STAT_TopDownAimYawSent, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Saved moves that skipped the aim yaw because it was unchanged since the last acknowledged move (client) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aim Yaw Skipped"), STAT_TopDownAimYawSkipped, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+// ========================================================================================
+// Movement
+// ========================================================================================
+
+/** Floors found by UTopDownMovementComponent's line-trace check instead of the capsule sweep */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Flat Floor Checks"), STAT_TopDownFlatFloorChecks, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Simulated proxy ticks at the reduced distant-proxy rate (client) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Distant Proxy Ticks"), STAT_TopDownDistantProxyTicks, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+// ========================================================================================
+// Ticking
+// ========================================================================================
+
+/** ATopDownCharacter::Tick calls (only the locally controlled character should tick) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Character Ticks"), STAT_TopDownCharacterTicks, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Scheduled reload completions (replaces per-frame reload polling in UWeaponComponent) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reload Timers Fired"), STAT_TopDownReloadTimersFired, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+// ========================================================================================
+// Respawn
+// ========================================================================================
+
+/** Respawns waiting in ATopDownGameMode's scheduler */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Respawn Queue Depth"), STAT_TopDownRespawnQueueDepth, STATGROUP_TopDown, TOPDOWNPROTO_API);
+
+/** Respawns performed this frame (capped by MaxRespawnsPerFrame) */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Respawns"), STAT_TopDownRespawns, STATGROUP_TopDown, TOPDOWNPROTO_API);
@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WeaponComponent.h"
+#include "LagCompensationSubsystem.h"
+#include "Projectile.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * TopDownProto.Weapon automation tests
+ *
+ * World-free checks of the shot timing math; run with
+ *   -ExecCmds="Automation RunTests TopDownProto.Weapon; quit"
+ */
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTopDownWeaponShotFlightTimeTest, "TopDownProto.Weapon.ShotFlightTime",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FTopDownWeaponShotFlightTimeTest::RunTest(const FString& Parameters)
+{
+	constexpr float InterpolationDelay = 0.05f;
+	constexpr float MaxRewindTime = 0.25f;
+	constexpr float ToleranceSeconds = 0.001f;
+
+	// 100 ms ping: the shot left the muzzle 50 ms ago, and its trigger RPC (hence the shot) reached the server 50 ms late
+	float RewindSeconds = 0.0f;
+	float ForwardSeconds = 0.0f;
+	ULagCompensationSubsystem::ComputeShotTiming(0.1f, InterpolationDelay, MaxRewindTime, RewindSeconds, ForwardSeconds);
+	TestNearlyEqual(TEXT("100 ms ping rewinds a round trip plus interpolation"), RewindSeconds, 0.15f, ToleranceSeconds);
+	TestNearlyEqual(TEXT("100 ms ping shot has flown one way"), ForwardSeconds, 0.05f, ToleranceSeconds);
+
+	const float TriggerFireDelay = 0.05f;
+	const float FlightSeconds = UWeaponComponent::GetShotFlightSeconds(true, ForwardSeconds, TriggerFireDelay);
+	TestNearlyEqual(TEXT("100 ms ping shot fired late is not moved a second one-way further"), FlightSeconds, 0.05f, ToleranceSeconds);
+
+	const AProjectile* Archetype = GetDefault<AProjectile>();
+	const float SpawnDistance = Archetype->InitialSpeed * FlightSeconds;
+	TestNearlyEqual(TEXT("100 ms ping shot starts 50 ms of travel from the muzzle"), SpawnDistance, Archetype->InitialSpeed * 0.05f,
+	                Archetype->InitialSpeed * ToleranceSeconds);
+
+	// A remote shot fired later than its one-way time (server hitch) has flown the longer of the two
+	TestNearlyEqual(TEXT("Hitch longer than one way wins"), UWeaponComponent::GetShotFlightSeconds(true, 0.05f, 0.08f), 0.08f, ToleranceSeconds);
+
+	// Local shooters only fly their sub-frame remainder; a shot scheduled in the future has not left yet
+	TestNearlyEqual(TEXT("Local shot flies its sub-frame remainder"), UWeaponComponent::GetShotFlightSeconds(false, 0.0f, 0.004f), 0.004f, ToleranceSeconds);
+	TestEqual(TEXT("Negative sub-frame time is clamped"), UWeaponComponent::GetShotFlightSeconds(false, 0.0f, -0.01f), 0.0f);
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
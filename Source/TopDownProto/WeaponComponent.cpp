@@ -2,22 +2,33 @@
 
 #include "WeaponComponent.h"
 #include "Projectile.h"
+#include "TopDownCombatLog.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ManagedProjectileSubsystem.h"
+#include "LagCompensationSubsystem.h"
+#include "CosmeticEventSubsystem.h"
+#include "TopDownStats.h"
 #include "TopDownCharacter.h"
+#include "TopDownHUD.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/GameStateBase.h"
+#include "TopDownGameState.h"
 
 UWeaponComponent::UWeaponComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame
-	PrimaryComponentTick.bCanEverTick = true;
+	// No per-frame work: reload completion is scheduled with a timer (see StartReload)
+	PrimaryComponentTick.bCanEverTick = false;
 
 	// Enable replication
 	SetIsReplicatedByDefault(true);
 
 	// Default weapon configuration
 	FireRate = 600.0f;                    // 600 RPM (10 shots per second)
+	MaxFireTimeRewind = 0.25f;            // Covers client timer jitter and a 4 Hz server frame
 	MagazineSize = 30;                    // 30 rounds per magazine
 	StartingReserveAmmo = 90;             // 90 reserve rounds (3 magazines)
 	MaxReserveAmmo = 150;                 // Maximum 150 reserve rounds
@@ -27,6 +38,12 @@ UWeaponComponent::UWeaponComponent()
 	// Projectile configuration
 	ProjectileClass = nullptr;            // Set in Blueprint
 	MuzzleOffset = FVector(100.0f, 0.0f, 0.0f);  // Forward offset for spawn location
+	ProjectileSimulationMode = EProjectileSimulationMode::Actor;
+	MaxCosmeticFastForward = 0.25f;
+
+	// Client prediction
+	bClientPrediction = true;
+	PredictionTimeout = 1.0f;             // Comfortably above a high-ping round trip plus net update interval
 
 	// Initialize ammo state
 	CurrentAmmo = MagazineSize;           // Start with full magazine
@@ -36,6 +53,10 @@ UWeaponComponent::UWeaponComponent()
 	WeaponState = EWeaponState::Idle;
 	NextFireTime = 0.0f;
 	ReloadCompleteTime = 0.0f;
+	LastShotKey = 0;
+	NextShotKey = 1;                      // Differs from LastShotKey so the first predicted shot isn't acknowledged early
+	PredictedReloadStartTime = 0.0f;
+	PushDirtyMask = 0;
 }
 
 void UWeaponComponent::BeginPlay()
@@ -45,57 +66,108 @@ void UWeaponComponent::BeginPlay()
 	// Initialize ammo on server
 	if (GetOwner() && GetOwner()->HasAuthority())
 	{
-		CurrentAmmo = MagazineSize;
-		ReserveAmmo = StartingReserveAmmo;
-		WeaponState = EWeaponState::Idle;
+		SetCurrentAmmo(MagazineSize);
+		SetReserveAmmo(StartingReserveAmmo);
+		SetWeaponState(EWeaponState::Idle);
 
 		UE_LOG(LogTemp, Log, TEXT("WeaponComponent initialized on server: %d/%d ammo"), CurrentAmmo, ReserveAmmo);
+
+		// Make sure our projectile class is pooled before the first shot
+		UProjectilePoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+		if (Pool && ProjectileSimulationMode == EProjectileSimulationMode::Actor)
+		{
+			Pool->Prewarm(ProjectileClass);
+		}
+	}
+	else if (ProjectileSimulationMode == EProjectileSimulationMode::ClientSimulated)
+	{
+		// Clients simulate cosmetic projectiles locally
+		if (UProjectilePoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UProjectilePoolSubsystem>() : nullptr)
+		{
+			Pool->Prewarm(ProjectileClass, INDEX_NONE, true);
+		}
 	}
 }
 
-void UWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UWeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// Handle reload completion on server
-	if (GetOwner() && GetOwner()->HasAuthority())
+	if (UWorld* World = GetWorld())
 	{
-		if (WeaponState == EWeaponState::Reloading && GetWorldTime() >= ReloadCompleteTime)
-		{
-			CompleteReload();
-		}
+		World->GetTimerManager().ClearTimer(ReloadTimerHandle);
+		World->GetTimerManager().ClearTimer(ReconcileTimerHandle);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UWeaponComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	// Replicate ammo and state
-	DOREPLIFETIME(UWeaponComponent, CurrentAmmo);
-	DOREPLIFETIME(UWeaponComponent, ReserveAmmo);
-	DOREPLIFETIME(UWeaponComponent, WeaponState);
-	DOREPLIFETIME(UWeaponComponent, NextFireTime);
-	DOREPLIFETIME(UWeaponComponent, ReloadCompleteTime);
+	// Replicate ammo and state (push model - only compared after a setter marks them dirty)
+	FDoRepLifetimeParams OwnerParams;
+	OwnerParams.bIsPushBased = true;
+	OwnerParams.Condition = COND_OwnerOnly;
+
+	FDoRepLifetimeParams SimulatedParams;
+	SimulatedParams.bIsPushBased = true;
+	SimulatedParams.Condition = COND_SkipOwner;
+
+	// Owner: full packed state for the HUD and client-side checks
+	DOREPLIFETIME_WITH_PARAMS_FAST(UWeaponComponent, OwnerState, OwnerParams);
+
+	// Everyone else: just the state enum for animation
+	DOREPLIFETIME_WITH_PARAMS_FAST(UWeaponComponent, WeaponState, SimulatedParams);
+}
+
+void UWeaponComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(WeaponPreReplication);
+
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Every push-based property not marked since the last net update is a compare the net driver skips
+	constexpr int32 NumPushProperties = 2;
+	INC_DWORD_STAT_BY(STAT_TopDownPushModelComparesSkipped, NumPushProperties - FMath::CountBits(PushDirtyMask));
+	PushDirtyMask = 0;
 }
 
 // ========================================================================================
 // Fire Rate System
 // ========================================================================================
 
+namespace WeaponComponent
+{
+	/** Slack for float rounding between a shot's scheduled time and the cooldown it is checked against */
+	constexpr float FireTimeTolerance = 0.001f;
+}
+
 bool UWeaponComponent::CanFire() const
+{
+	return CanFireAt(GetWorldTime());
+}
+
+bool UWeaponComponent::CanFireAt(float ShotTime) const
 {
 	// Can fire if:
 	// 1. Has ammo
 	// 2. Not currently reloading
-	// 3. Fire cooldown has elapsed
+	// 3. Fire cooldown has elapsed by the time the shot was scheduled for
 	return HasAmmo() && 
 	       WeaponState != EWeaponState::Reloading && 
-	       GetWorldTime() >= NextFireTime;
+	       ShotTime + WeaponComponent::FireTimeTolerance >= NextFireTime;
 }
 
-bool UWeaponComponent::TryFire(const FVector& FireDirection)
+float UWeaponComponent::ClampClientFireTime(float ClientFireTime) const
 {
+	const float Now = GetWorldTime();
+	return FMath::Clamp(ClientFireTime, Now - MaxFireTimeRewind, Now);
+}
+
+bool UWeaponComponent::TryFire(const FVector& FireDirection, float ShotTime)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(TryFire);
+
 	// This should only be called on server
 	if (!GetOwner() || !GetOwner()->HasAuthority())
 	{
@@ -103,64 +175,50 @@ bool UWeaponComponent::TryFire(const FVector& FireDirection)
 		return false;
 	}
 
+	// Shots are timed at their schedule, not at the frame that happens to process them
+	const float Now = GetWorldTime();
+	ShotTime = ShotTime < 0.0f ? Now : FMath::Clamp(ShotTime, Now - MaxFireTimeRewind, Now);
+
 	// Check if we can fire
-	if (!CanFire())
+	if (!CanFireAt(ShotTime))
 	{
 		return false;
 	}
 
+	// Acknowledges the owning client's prediction of this shot
+	SetLastShotKey(NextShotKey++);
+
 	// Update weapon state to firing
-	WeaponState = EWeaponState::Firing;
+	SetWeaponState(EWeaponState::Firing);
 
 	// Spawn projectile if class is set
-	if (ProjectileClass && GetWorld())
+	if (ProjectileClass && GetWorld() && GetOwner())
 	{
-		AActor* Owner = GetOwner();
-		if (Owner)
+		// Calculate spawn location (muzzle position) using fire direction
+		FRotator FireRotation = FireDirection.Rotation();
+		FVector SpawnLocation = GetOwner()->GetActorLocation() + FireRotation.RotateVector(MuzzleOffset);
+
+		if (!ResolveLagCompensatedShot(SpawnLocation, FireDirection, Now - ShotTime))
 		{
-			// Calculate spawn location (muzzle position) using fire direction
-			FRotator FireRotation = FireDirection.Rotation();
-			FVector SpawnLocation = Owner->GetActorLocation() + FireRotation.RotateVector(MuzzleOffset);
-
-			// Set spawn parameters
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.Owner = Owner;
-			SpawnParams.Instigator = Cast<APawn>(Owner);
-			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-			// Spawn projectile
-			AProjectile* Projectile = GetWorld()->SpawnActor<AProjectile>(
-				ProjectileClass,
-				SpawnLocation,
-				FireRotation,
-				SpawnParams
-			);
-
-			if (Projectile)
-			{
-				// Fire projectile in the specified direction
-				Projectile->FireInDirection(FireDirection);
-				
-				UE_LOG(LogTemp, Log, TEXT("Spawned projectile at %s facing %s"), 
-				       *SpawnLocation.ToString(), *FireDirection.ToString());
-			}
+			LaunchProjectile(SpawnLocation, FireDirection);
 		}
 	}
 
 	// Consume ammo (this may trigger auto-reload if magazine becomes empty)
 	ConsumeAmmo();
 
-	// Set next fire time (fire rate limiting)
-	NextFireTime = GetWorldTime() + GetFireCooldown();
+	// Set next fire time (fire rate limiting) from the scheduled time so frame quantization doesn't lower the rate
+	SetNextFireTime(ShotTime + GetFireCooldown());
 
 	// Return to idle state only if not reloading
 	// (ConsumeAmmo may have started reload if magazine is now empty)
 	if (WeaponState != EWeaponState::Reloading)
 	{
-		WeaponState = EWeaponState::Idle;
+		SetWeaponState(EWeaponState::Idle);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Weapon fired! Ammo: %d/%d"), CurrentAmmo, ReserveAmmo);
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Weapon fired! Ammo: %d/%d"), CurrentAmmo, ReserveAmmo);
+	TOPDOWN_INC_COUNTER(ShotsFired, 1);
 
 	return true;
 }
@@ -189,14 +247,14 @@ void UWeaponComponent::ConsumeAmmo()
 {
 	if (GetOwner() && GetOwner()->HasAuthority())
 	{
-		CurrentAmmo = FMath::Max(0, CurrentAmmo - 1);
+		SetCurrentAmmo(FMath::Max(0, CurrentAmmo - 1));
 		
 		// Update HUD on server (OnRep doesn't fire on server)
 		if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner()))
 		{
 			if (Character->IsLocallyControlled())
 			{
-				Character->UpdateHUDDisplay();
+				Character->UpdateHUDDisplay(EHUDDirtyFlags::Ammo);
 			}
 		}
 		
@@ -213,11 +271,12 @@ void UWeaponComponent::ResetAmmo()
 {
 	if (GetOwner() && GetOwner()->HasAuthority())
 	{
-		CurrentAmmo = MagazineSize;
-		ReserveAmmo = StartingReserveAmmo;
-		WeaponState = EWeaponState::Idle;
-		NextFireTime = 0.0f;
-		ReloadCompleteTime = 0.0f;
+		SetCurrentAmmo(MagazineSize);
+		SetReserveAmmo(StartingReserveAmmo);
+		SetWeaponState(EWeaponState::Idle);
+		SetNextFireTime(0.0f);
+		SetReloadCompleteTime(0.0f);
+		GetWorld()->GetTimerManager().ClearTimer(ReloadTimerHandle);
 
 		UE_LOG(LogTemp, Log, TEXT("Ammo reset to %d/%d"), CurrentAmmo, ReserveAmmo);
 	}
@@ -254,10 +313,19 @@ bool UWeaponComponent::StartReload()
 	}
 
 	// Set weapon state to reloading
-	WeaponState = EWeaponState::Reloading;
-	
-	// Set reload completion time
-	ReloadCompleteTime = GetWorldTime() + ReloadTime;
+	SetWeaponState(EWeaponState::Reloading);
+
+	// ClampMin doesn't bind Blueprint writes, and a timer with a zero rate is never set,
+	// which would leave the weapon reloading for good; an instant reload just completes
+	if (ReloadTime <= 0.0f)
+	{
+		CompleteReload();
+		return true;
+	}
+
+	// Set reload completion time and schedule the completion (no polling)
+	SetReloadCompleteTime(GetWorldTime() + ReloadTime);
+	GetWorld()->GetTimerManager().SetTimer(ReloadTimerHandle, this, &UWeaponComponent::OnReloadTimerElapsed, ReloadTime, false);
 
 	UE_LOG(LogTemp, Log, TEXT("Reload started. Will complete in %.2f seconds"), ReloadTime);
 
@@ -272,6 +340,9 @@ void UWeaponComponent::CompleteReload()
 		return;
 	}
 
+	// Completing early (e.g. from Blueprint) must not let the scheduled completion fire again
+	GetWorld()->GetTimerManager().ClearTimer(ReloadTimerHandle);
+
 	// Calculate how much ammo we need to fill the magazine
 	int32 AmmoNeeded = MagazineSize - CurrentAmmo;
 	
@@ -279,25 +350,35 @@ void UWeaponComponent::CompleteReload()
 	int32 AmmoToReload = FMath::Min(AmmoNeeded, ReserveAmmo);
 	
 	// Transfer ammo
-	CurrentAmmo += AmmoToReload;
-	ReserveAmmo -= AmmoToReload;
+	SetCurrentAmmo(CurrentAmmo + AmmoToReload);
+	SetReserveAmmo(ReserveAmmo - AmmoToReload);
 
 	// Return to idle state
-	WeaponState = EWeaponState::Idle;
-	ReloadCompleteTime = 0.0f;
+	SetWeaponState(EWeaponState::Idle);
+	SetReloadCompleteTime(0.0f);
 
 	// Update HUD on server (OnRep doesn't fire on server)
 	if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner()))
 	{
 		if (Character->IsLocallyControlled())
 		{
-			Character->UpdateHUDDisplay();
+			Character->UpdateHUDDisplay(EHUDDirtyFlags::Ammo | EHUDDirtyFlags::Reserve);
 		}
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Reload completed! Ammo: %d/%d"), CurrentAmmo, ReserveAmmo);
 }
 
+void UWeaponComponent::OnReloadTimerElapsed()
+{
+	INC_DWORD_STAT(STAT_TopDownReloadTimersFired);
+
+	if (WeaponState == EWeaponState::Reloading)
+	{
+		CompleteReload();
+	}
+}
+
 void UWeaponComponent::CancelReload()
 {
 	if (!GetOwner() || !GetOwner()->HasAuthority())
@@ -307,44 +388,365 @@ void UWeaponComponent::CancelReload()
 
 	if (WeaponState == EWeaponState::Reloading)
 	{
+		SetWeaponState(EWeaponState::Idle);
+		SetReloadCompleteTime(0.0f);
+		GetWorld()->GetTimerManager().ClearTimer(ReloadTimerHandle);
+		UE_LOG(LogTemp, Log, TEXT("Reload cancelled"));
+	}
+}
+
+// ========================================================================================
+// Client Prediction
+// ========================================================================================
+
+bool UWeaponComponent::IsPredictingLocally() const
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	return bClientPrediction && Pawn && !Pawn->HasAuthority() && Pawn->IsLocallyControlled();
+}
+
+bool UWeaponComponent::PredictFire(const FVector& FireDirection, float ShotTime)
+{
+	const float Now = GetWorldTime();
+	ShotTime = ShotTime < 0.0f ? Now : FMath::Clamp(ShotTime, Now - MaxFireTimeRewind, Now);
+
+	// CanFireAt sees the predicted ammo, state and cooldown
+	if (!IsPredictingLocally() || !CanFireAt(ShotTime))
+	{
+		return false;
+	}
+
+	PendingShots.Add({NextShotKey++, ShotTime});
+
+	// The server will start the auto-reload when this shot empties the magazine
+	if (CurrentAmmo == 1 && bAutoReloadWhenEmpty && HasReserveAmmo())
+	{
+		PredictedReloadStartTime = ShotTime;
+	}
+
+	// Cosmetic projectile now; the server's fire event skips us
+	if (ProjectileSimulationMode == EProjectileSimulationMode::ClientSimulated && ProjectileClass)
+	{
+		const FVector Origin = GetOwner()->GetActorLocation() + FireDirection.Rotation().RotateVector(MuzzleOffset);
+		SpawnCosmeticProjectile(ProjectileClass, Origin, FireDirection, Now - ShotTime);
+	}
+
+	ReconcilePrediction();
+	return true;
+}
+
+bool UWeaponComponent::PredictReload()
+{
+	if (!IsPredictingLocally() || !CanReload())
+	{
+		return false;
+	}
+
+	PredictedReloadStartTime = GetWorldTime();
+	ReconcilePrediction();
+	return true;
+}
+
+void UWeaponComponent::ClearPrediction()
+{
+	if (PendingShots.Num() > 0 || PredictedReloadStartTime > 0.0f)
+	{
+		PendingShots.Reset();
+		PredictedReloadStartTime = 0.0f;
+		ReconcilePrediction();
+	}
+}
+
+void UWeaponComponent::ReconcilePrediction()
+{
+	const float Now = GetWorldTime();
+	const bool bPredicting = IsPredictingLocally();
+
+	// Shots the server fired are acknowledged; shots it never fired eventually time out
+	PendingShots.RemoveAll([this, Now](const FPredictedShot& Shot)
+	{
+		const bool bAcknowledged = static_cast<uint8>(OwnerState.LastShotKey - Shot.Key) < 128;
+		return bAcknowledged || Now - Shot.Time > PredictionTimeout;
+	});
+
+	// A predicted reload is acknowledged once the server is reloading too
+	if (PredictedReloadStartTime > 0.0f
+		&& (OwnerState.WeaponState == EWeaponState::Reloading || Now - PredictedReloadStartTime > PredictionTimeout))
+	{
+		PredictedReloadStartTime = 0.0f;
+	}
+
+	const int32 OldAmmo = CurrentAmmo;
+	const int32 OldReserveAmmo = ReserveAmmo;
+	const EWeaponState OldWeaponState = WeaponState;
+
+	// Start from the server's state...
+	CurrentAmmo = OwnerState.CurrentAmmo;
+	ReserveAmmo = OwnerState.ReserveAmmo;
+	WeaponState = OwnerState.WeaponState;
+	NextFireTime = FromMatchCentiseconds(OwnerState.NextFireTimeCs);
+	ReloadCompleteTime = FromMatchCentiseconds(OwnerState.ReloadCompleteTimeCs);
+
+	// ...and replay what it has not seen yet
+	if (PredictedReloadStartTime > 0.0f && WeaponState != EWeaponState::Reloading)
+	{
+		WeaponState = EWeaponState::Reloading;
+		ReloadCompleteTime = PredictedReloadStartTime + ReloadTime;
+	}
+
+	int32 ShotsAfterReload = 0;
+	for (const FPredictedShot& Shot : PendingShots)
+	{
+		if (WeaponState == EWeaponState::Reloading && Shot.Time >= ReloadCompleteTime)
+		{
+			ShotsAfterReload++;
+		}
+		else
+		{
+			CurrentAmmo = FMath::Max(0, CurrentAmmo - 1);
+		}
+	}
+
+	// The server's reload completion is still on the wire - finish it locally on time
+	if (bPredicting && WeaponState == EWeaponState::Reloading && ReloadCompleteTime > 0.0f && Now >= ReloadCompleteTime)
+	{
+		const int32 AmmoToReload = FMath::Min(MagazineSize - CurrentAmmo, ReserveAmmo);
+		CurrentAmmo += AmmoToReload;
+		ReserveAmmo -= AmmoToReload;
 		WeaponState = EWeaponState::Idle;
 		ReloadCompleteTime = 0.0f;
-		UE_LOG(LogTemp, Log, TEXT("Reload cancelled"));
+	}
+	CurrentAmmo = FMath::Max(0, CurrentAmmo - ShotsAfterReload);
+
+	if (PendingShots.Num() > 0)
+	{
+		NextFireTime = FMath::Max(NextFireTime, PendingShots.Last().Time + GetFireCooldown());
+	}
+
+	// Come back when a prediction expires or a reload is due
+	float NextReconcileTime = MAX_flt;
+	if (PendingShots.Num() > 0)
+	{
+		NextReconcileTime = PendingShots[0].Time + PredictionTimeout;
+	}
+	if (PredictedReloadStartTime > 0.0f)
+	{
+		NextReconcileTime = FMath::Min(NextReconcileTime, PredictedReloadStartTime + PredictionTimeout);
+	}
+	if (bPredicting && WeaponState == EWeaponState::Reloading && ReloadCompleteTime > 0.0f)
+	{
+		NextReconcileTime = FMath::Min(NextReconcileTime, ReloadCompleteTime);
+	}
+	if (UWorld* World = GetWorld())
+	{
+		if (NextReconcileTime < MAX_flt)
+		{
+			World->GetTimerManager().SetTimer(ReconcileTimerHandle, this, &UWeaponComponent::ReconcilePrediction,
+			                                  FMath::Max(NextReconcileTime - Now, 0.01f), false);
+		}
+		else
+		{
+			World->GetTimerManager().ClearTimer(ReconcileTimerHandle);
+		}
+	}
+
+	EHUDDirtyFlags HUDFields = EHUDDirtyFlags::None;
+	if (CurrentAmmo != OldAmmo)
+	{
+		HUDFields |= EHUDDirtyFlags::Ammo;
+	}
+	if (ReserveAmmo != OldReserveAmmo)
+	{
+		HUDFields |= EHUDDirtyFlags::Reserve;
+	}
+	if (WeaponState != OldWeaponState)
+	{
+		HUDFields |= EHUDDirtyFlags::State;
+	}
+
+	if (EnumHasAnyFlags(HUDFields, EHUDDirtyFlags::Ammo | EHUDDirtyFlags::Reserve))
+	{
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Client: Ammo updated to %d/%d (%d shots predicted)"), CurrentAmmo, ReserveAmmo, PendingShots.Num());
+	}
+
+	// One HUD flush for everything this update touched
+	if (HUDFields != EHUDDirtyFlags::None)
+	{
+		if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner()))
+		{
+			Character->UpdateHUDDisplay(HUDFields);
+		}
+	}
+
+	if (EnumHasAnyFlags(HUDFields, EHUDDirtyFlags::State))
+	{
+		OnRep_WeaponState();
 	}
 }
 
 // ========================================================================================
-// Replication Callbacks
+// Push Model Setters
 // ========================================================================================
 
-void UWeaponComponent::OnRep_CurrentAmmo()
+void UWeaponComponent::NotePushDirty(uint8 PropertyBit)
 {
-	// Called on clients when CurrentAmmo changes
-	UE_LOG(LogTemp, Log, TEXT("Client: Current ammo updated to %d"), CurrentAmmo);
-	
-	// Update HUD
-	if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner()))
+	PushDirtyMask |= PropertyBit;
+	INC_DWORD_STAT(STAT_TopDownPushModelDirtyMarks);
+}
+
+void UWeaponComponent::SetCurrentAmmo(int32 NewCurrentAmmo)
+{
+	if (CurrentAmmo != NewCurrentAmmo)
 	{
-		Character->UpdateHUDDisplay();
+		CurrentAmmo = NewCurrentAmmo;
+		PackOwnerState();
 	}
 }
 
-void UWeaponComponent::OnRep_ReserveAmmo()
+void UWeaponComponent::SetReserveAmmo(int32 NewReserveAmmo)
 {
-	// Called on clients when ReserveAmmo changes
-	UE_LOG(LogTemp, Log, TEXT("Client: Reserve ammo updated to %d"), ReserveAmmo);
+	if (ReserveAmmo != NewReserveAmmo)
+	{
+		ReserveAmmo = NewReserveAmmo;
+		PackOwnerState();
+	}
+}
 
-	// Update HUD
-	if (ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner()))
+void UWeaponComponent::SetWeaponState(EWeaponState NewWeaponState)
+{
+	if (WeaponState != NewWeaponState)
 	{
-		Character->UpdateHUDDisplay();
+		WeaponState = NewWeaponState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UWeaponComponent, WeaponState, this);
+		NotePushDirty(1 << 1);
+		PackOwnerState();
+
+		// Listen server host (OnRep doesn't fire on server)
+		ATopDownCharacter* Character = Cast<ATopDownCharacter>(GetOwner());
+		if (Character && Character->IsLocallyControlled())
+		{
+			Character->UpdateHUDDisplay(EHUDDirtyFlags::State);
+		}
 	}
 }
 
+void UWeaponComponent::SetNextFireTime(float NewNextFireTime)
+{
+	if (NextFireTime != NewNextFireTime)
+	{
+		NextFireTime = NewNextFireTime;
+		PackOwnerState();
+	}
+}
+
+void UWeaponComponent::SetReloadCompleteTime(float NewReloadCompleteTime)
+{
+	if (ReloadCompleteTime != NewReloadCompleteTime)
+	{
+		ReloadCompleteTime = NewReloadCompleteTime;
+		PackOwnerState();
+	}
+}
+
+void UWeaponComponent::SetLastShotKey(uint8 NewLastShotKey)
+{
+	if (LastShotKey != NewLastShotKey)
+	{
+		LastShotKey = NewLastShotKey;
+		PackOwnerState();
+	}
+}
+
+float UWeaponComponent::GetMatchClockBase() const
+{
+	// Before the game state arrives on a client both sides fall back to raw world time
+	const ATopDownGameState* GameState = GetWorld() ? GetWorld()->GetGameState<ATopDownGameState>() : nullptr;
+	return GameState ? GameState->GetMatchStartTime() : 0.0f;
+}
+
+float UWeaponComponent::FromMatchCentiseconds(uint32 TimeCs) const
+{
+	return TimeCs != 0 ? GetMatchClockBase() + TimeCs * 0.01f : 0.0f;
+}
+
+void UWeaponComponent::PackOwnerState()
+{
+	const float ClockBase = GetMatchClockBase();
+	auto ToCentiseconds = [ClockBase](float Time) -> uint32
+	{
+		// 0 is reserved for "not set"
+		return Time > 0.0f ? static_cast<uint32>(FMath::Max(1, FMath::RoundToInt32((Time - ClockBase) * 100.0f))) : 0;
+	};
+
+	FWeaponReplicatedState NewState;
+	NewState.CurrentAmmo = static_cast<uint16>(FMath::Clamp(CurrentAmmo, 0, MAX_uint16));
+	NewState.ReserveAmmo = static_cast<uint16>(FMath::Clamp(ReserveAmmo, 0, MAX_uint16));
+	NewState.WeaponState = WeaponState;
+	NewState.NextFireTimeCs = ToCentiseconds(NextFireTime);
+	NewState.ReloadCompleteTimeCs = ToCentiseconds(ReloadCompleteTime);
+	NewState.LastShotKey = LastShotKey;
+
+	if (NewState != OwnerState)
+	{
+		OwnerState = NewState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UWeaponComponent, OwnerState, this);
+		NotePushDirty(1 << 0);
+	}
+}
+
+bool FWeaponReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedAmmo = FMath::Min<uint32>(CurrentAmmo, (1u << AmmoBits) - 1);
+	uint32 PackedReserveAmmo = FMath::Min<uint32>(ReserveAmmo, (1u << ReserveAmmoBits) - 1);
+	uint32 PackedState = static_cast<uint32>(WeaponState);
+
+	Ar.SerializeInt(PackedAmmo, 1u << AmmoBits);
+	Ar.SerializeInt(PackedReserveAmmo, 1u << ReserveAmmoBits);
+	Ar.SerializeInt(PackedState, 1u << StateBits);
+
+	// Times are usually unset (no reload pending), so each costs a single bit then
+	auto SerializeTime = [&Ar](uint32& TimeCs)
+	{
+		uint8 bHasTime = TimeCs != 0 ? 1 : 0;
+		Ar.SerializeBits(&bHasTime, 1);
+
+		uint32 PackedTime = bHasTime ? FMath::Min<uint32>(TimeCs, (1u << TimeBits) - 1) : 0;
+		if (bHasTime)
+		{
+			Ar.SerializeInt(PackedTime, 1u << TimeBits);
+		}
+		TimeCs = PackedTime;
+	};
+	SerializeTime(NextFireTimeCs);
+	SerializeTime(ReloadCompleteTimeCs);
+
+	Ar.SerializeBits(&LastShotKey, ShotKeyBits);
+
+	if (Ar.IsLoading())
+	{
+		CurrentAmmo = static_cast<uint16>(PackedAmmo);
+		ReserveAmmo = static_cast<uint16>(PackedReserveAmmo);
+		WeaponState = static_cast<EWeaponState>(FMath::Min<uint32>(PackedState, static_cast<uint32>(EWeaponState::Reloading)));
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// ========================================================================================
+// Replication Callbacks
+// ========================================================================================
+
+void UWeaponComponent::OnRep_OwnerState()
+{
+	// Called on the owning client when its packed weapon state changes
+	ReconcilePrediction();
+}
+
 void UWeaponComponent::OnRep_WeaponState()
 {
 	// Called on clients when WeaponState changes
-	UE_LOG(LogTemp, Log, TEXT("Client: Weapon state changed to %d"), (int32)WeaponState);
+	TOPDOWN_COMBAT_LOG(Log, TEXT("Client: Weapon state changed to %d"), (int32)WeaponState);
 	
 	// Here you could trigger animations, sound effects, etc. based on state
 	switch (WeaponState)
@@ -361,10 +763,195 @@ void UWeaponComponent::OnRep_WeaponState()
 	}
 }
 
+void UWeaponComponent::MulticastProjectileFired_Implementation(const FProjectileFireEvent& FireEvent)
+{
+	// Dedicated servers have nothing to show
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_DedicatedServer || !FireEvent.Archetype)
+	{
+		return;
+	}
+
+	// The owner spawned its own when it predicted the shot
+	if (IsPredictingLocally())
+	{
+		return;
+	}
+
+	const FRotator FireRotation(0.0f, FRotator::DecompressAxisFromShort(FireEvent.Yaw), 0.0f);
+
+	// Fast-forward by the time the event spent on the wire
+	const AGameStateBase* GameState = World->GetGameState();
+	const float ServerNow = GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	SpawnCosmeticProjectile(FireEvent.Archetype, FireEvent.Origin, FireRotation.Vector(), ServerNow - FireEvent.ServerFireTime);
+}
+
 // ========================================================================================
 // Internal Helper Functions
 // ========================================================================================
 
+float UWeaponComponent::GetShotFlightSeconds(bool bCompensated, float ForwardSeconds, float SubFrameSeconds)
+{
+	// A shot scheduled earlier in the frame has already been flying that long; for a remote
+	// shot, the one-way flight time already covers the wait for the trigger RPC
+	SubFrameSeconds = FMath::Max(0.0f, SubFrameSeconds);
+	return bCompensated ? FMath::Max(ForwardSeconds, SubFrameSeconds) : SubFrameSeconds;
+}
+
+bool UWeaponComponent::ResolveLagCompensatedShot(FVector& InOutSpawnLocation, const FVector& FireDirection, float SubFrameSeconds)
+{
+	ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	APawn* Shooter = Cast<APawn>(GetOwner());
+
+	float RewindSeconds = 0.0f;
+	float ForwardSeconds = 0.0f;
+	const bool bCompensated = LagCompensation && LagCompensation->GetShotTiming(Shooter, RewindSeconds, ForwardSeconds);
+
+	const float FlightSeconds = GetShotFlightSeconds(bCompensated, ForwardSeconds, SubFrameSeconds);
+	if (FlightSeconds <= 0.0f)
+	{
+		return false;
+	}
+
+	const AProjectile* Archetype = ProjectileClass->GetDefaultObject<AProjectile>();
+	const FVector ForwardLocation = InOutSpawnLocation + FireDirection * Archetype->InitialSpeed * FlightSeconds;
+
+	FHitResult Hit;
+	bool bHit = false;
+	if (bCompensated)
+	{
+		bHit = LagCompensation->RewindSweep(Shooter, RewindSeconds, InOutSpawnLocation, ForwardLocation, Archetype, Hit);
+	}
+	else
+	{
+		// Local shooter: nothing to rewind, just the sub-frame segment against the present
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SubFrameShot), false, Shooter);
+		bHit = Archetype->SweepFlight(GetWorld(), InOutSpawnLocation, ForwardLocation, QueryParams, Hit);
+	}
+
+	if (bHit)
+	{
+		// No projectile will be launched, so this is the only impact anyone sees
+		if (UCosmeticEventSubsystem* CosmeticEvents = GetWorld()->GetSubsystem<UCosmeticEventSubsystem>())
+		{
+			CosmeticEvents->QueueEvent(ECosmeticEventType::Impact, ProjectileClass, Hit.ImpactPoint, Hit.ImpactNormal);
+		}
+
+		if (AActor* HitActor = Hit.GetActor())
+		{
+			AProjectile::ApplyProjectileDamage(HitActor, Archetype->Damage, Shooter ? Shooter->GetController() : nullptr, Shooter);
+		}
+		return true;
+	}
+
+	InOutSpawnLocation = ForwardLocation;
+	return false;
+}
+
+void UWeaponComponent::LaunchProjectile(const FVector& SpawnLocation, const FVector& FireDirection)
+{
+	TOPDOWN_SCOPE_CYCLE_COUNTER(LaunchProjectile);
+
+	AActor* Owner = GetOwner();
+	APawn* InstigatorPawn = Cast<APawn>(Owner);
+	const FRotator FireRotation = FireDirection.Rotation();
+
+	// Managed/ClientSimulated modes - no actor, simulated in a batch by the subsystem
+	if (ProjectileSimulationMode != EProjectileSimulationMode::Actor)
+	{
+		if (UManagedProjectileSubsystem* Managed = GetWorld()->GetSubsystem<UManagedProjectileSubsystem>())
+		{
+			// Client-simulated shots show their own impacts; clients must never draw a shot the server isn't simulating
+			if (!Managed->SpawnProjectile(ProjectileClass, SpawnLocation, FireDirection, InstigatorPawn,
+			                              ProjectileSimulationMode == EProjectileSimulationMode::Managed))
+			{
+				return;
+			}
+
+			// Clients only need to know where and when the shot happened
+			if (ProjectileSimulationMode == EProjectileSimulationMode::ClientSimulated)
+			{
+				const AGameStateBase* GameState = GetWorld()->GetGameState();
+
+				FProjectileFireEvent FireEvent;
+				FireEvent.Origin = SpawnLocation;
+				FireEvent.Yaw = FRotator::CompressAxisToShort(FireRotation.Yaw);
+				FireEvent.ServerFireTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorldTime();
+				FireEvent.Archetype = ProjectileClass;
+				MulticastProjectileFired(FireEvent);
+			}
+			return;
+		}
+	}
+
+	// Take projectile from the pool (falls back to spawning if there is no pool)
+	AProjectile* Projectile = nullptr;
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Projectile = Pool->AcquireProjectile(ProjectileClass, SpawnLocation, FireRotation, Owner, InstigatorPawn);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Owner;
+		SpawnParams.Instigator = InstigatorPawn;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		Projectile = GetWorld()->SpawnActor<AProjectile>(
+			ProjectileClass,
+			SpawnLocation,
+			FireRotation,
+			SpawnParams
+		);
+	}
+
+	if (Projectile)
+	{
+		// Fire projectile in the specified direction
+		Projectile->FireInDirection(FireDirection);
+
+		TOPDOWN_COMBAT_LOG(Log, TEXT("Spawned projectile at %s facing %s"),
+		                   *SpawnLocation.ToString(), *FireDirection.ToString());
+	}
+}
+
+void UWeaponComponent::SpawnCosmeticProjectile(TSubclassOf<AProjectile> ArchetypeClass, const FVector& Origin, const FVector& FireDirection, float Elapsed)
+{
+	UWorld* World = GetWorld();
+	if (!World || !ArchetypeClass)
+	{
+		return;
+	}
+
+	const AProjectile* Archetype = ArchetypeClass->GetDefaultObject<AProjectile>();
+	Elapsed = FMath::Clamp(Elapsed, 0.0f, FMath::Min(MaxCosmeticFastForward, Archetype->Lifetime));
+
+	FVector SpawnLocation = Origin;
+	if (Elapsed > 0.0f)
+	{
+		// The skipped segment may already have hit something (what the server's shot would block on)
+		const FVector FastForwardEnd = Origin + FireDirection * Archetype->InitialSpeed * Elapsed;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CosmeticProjectileFastForward), false, GetOwner());
+		FHitResult Hit;
+		if (Archetype->SweepFlight(World, Origin, FastForwardEnd, QueryParams, Hit))
+		{
+			Archetype->PlayHitEffects(World, Hit.ImpactPoint, Hit.ImpactNormal);
+			return;
+		}
+
+		SpawnLocation = FastForwardEnd;
+	}
+
+	if (UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		if (AProjectile* Projectile = Pool->AcquireProjectile(ArchetypeClass, SpawnLocation, FireDirection.Rotation(), GetOwner(), Cast<APawn>(GetOwner()), true))
+		{
+			Projectile->FireInDirection(FireDirection);
+		}
+	}
+}
+
 float UWeaponComponent::GetFireCooldown() const
 {
 	// Convert RPM to seconds between shots
@@ -375,10 +962,11 @@ float UWeaponComponent::GetFireCooldown() const
 
 float UWeaponComponent::GetWorldTime() const
 {
-	if (GetWorld())
+	if (const UWorld* World = GetWorld())
 	{
-		// Use server time if we're the server, or approximate client time
-		return GetWorld()->GetTimeSeconds();
+		// Server time on the server, estimated server time on clients (replicated times are in the server's clock)
+		const AGameStateBase* GameState = World->GetGameState();
+		return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
 	}
 	return 0.0f;
 }
@@ -21,14 +21,104 @@ enum class EWeaponState : uint8
 	Reloading    UMETA(DisplayName = "Reloading")
 };
 
+/**
+ * EProjectileSimulationMode
+ * 
+ * Defines how fired projectiles are simulated
+ */
+UENUM(BlueprintType)
+enum class EProjectileSimulationMode : uint8
+{
+	Actor        UMETA(DisplayName = "Actor", ToolTip = "Pooled, replicated AProjectile actor per shot"),
+	Managed      UMETA(DisplayName = "Managed", ToolTip = "Batched server-side simulation in UManagedProjectileSubsystem, no actor per shot"),
+	ClientSimulated UMETA(DisplayName = "Client Simulated", ToolTip = "Managed on the server, clients simulate cosmetic projectiles from replicated fire events")
+};
+
+/**
+ * FProjectileFireEvent
+ * 
+ * Compact description of a shot sent to clients in ClientSimulated mode.
+ * Clients spawn a local cosmetic projectile from it; the server stays authoritative for hits.
+ */
+USTRUCT()
+struct FProjectileFireEvent
+{
+	GENERATED_BODY()
+
+	/** Muzzle location at fire time */
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	/** Fire yaw compressed with FRotator::CompressAxisToShort */
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	/** Server world time the shot was fired at (used to fast-forward on clients) */
+	UPROPERTY()
+	float ServerFireTime = 0.0f;
+
+	/** Projectile class to simulate */
+	UPROPERTY()
+	TSubclassOf<AProjectile> Archetype;
+};
+
+/**
+ * FWeaponReplicatedState
+ * 
+ * Owner-only weapon state, bit-packed by a custom NetSerialize.
+ * Times are stored in centiseconds since the match started (ATopDownGameState::GetMatchStartTime),
+ * 0 meaning "not set". Simulated proxies never receive this, only the 2-bit WeaponState.
+ * LastShotKey acknowledges the owning client's predicted shots (see UWeaponComponent::PredictFire).
+ */
+USTRUCT()
+struct FWeaponReplicatedState
+{
+	GENERATED_BODY()
+
+	uint16 CurrentAmmo = 0;
+	uint16 ReserveAmmo = 0;
+	EWeaponState WeaponState = EWeaponState::Idle;
+	uint32 NextFireTimeCs = 0;
+	uint32 ReloadCompleteTimeCs = 0;
+	uint8 LastShotKey = 0;
+
+	/** Wire widths (values are clamped to fit) */
+	static constexpr uint32 AmmoBits = 10;          // 0-1023 rounds in the magazine
+	static constexpr uint32 ReserveAmmoBits = 12;   // 0-4095 rounds in reserve
+	static constexpr uint32 StateBits = 2;          // Idle/Firing/Reloading
+	static constexpr uint32 TimeBits = 24;          // ~46 hours of match time at 10 ms resolution
+	static constexpr uint32 ShotKeyBits = 8;        // Wraps; compared modulo 256
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FWeaponReplicatedState& Other) const
+	{
+		return CurrentAmmo == Other.CurrentAmmo && ReserveAmmo == Other.ReserveAmmo && WeaponState == Other.WeaponState
+			&& NextFireTimeCs == Other.NextFireTimeCs && ReloadCompleteTimeCs == Other.ReloadCompleteTimeCs
+			&& LastShotKey == Other.LastShotKey;
+	}
+	bool operator!=(const FWeaponReplicatedState& Other) const { return !(*this == Other); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FWeaponReplicatedState> : public TStructOpsTypeTraitsBase2<FWeaponReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
 /**
  * UWeaponComponent
  * 
  * Actor component that handles weapon functionality including:
  * - Ammunition management (current, reserve, magazine size)
  * - Fire rate limiting with cooldown system
- * - Reload mechanics (manual and automatic)
+ * - Reload mechanics (manual and automatic), completed by a timer - the component never ticks
  * - Network replication of ammo state
+ * - Owning-client prediction of fire, ammo and reload, reconciled against the replicated state
  * 
  * This component should be attached to the player character.
  */
@@ -45,12 +135,13 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// Called when the component is removed; clears the pending reload timer
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+public:	
 	//~ Begin UActorComponent Interface
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	//~ End UActorComponent Interface
 
 	// ========================================================================================
@@ -68,10 +159,38 @@ public:
 	 * Called when player attempts to fire weapon
 	 * Handles fire rate limiting and ammo consumption
 	 * @param FireDirection - Direction to fire the projectile (should be normalized)
+	 * @param ShotTime - Server time the shot was scheduled for, at most MaxFireTimeRewind ago (< 0 = now);
+	 *                   the cooldown runs from it and the projectile starts as far along its path as it
+	 *                   would have flown since, so the fire rate does not depend on the server tick rate
 	 * @return True if weapon was successfully fired
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
-	bool TryFire(const FVector& FireDirection);
+	bool TryFire(const FVector& FireDirection, float ShotTime = -1.0f);
+
+	/**
+	 * Map a client's fire timestamp to a server time the server will honour
+	 * @param ClientFireTime - Client's estimate of server time when it fired (GetServerWorldTimeSeconds)
+	 * @return ClientFireTime clamped to [now - MaxFireTimeRewind, now]
+	 */
+	float ClampClientFireTime(float ClientFireTime) const;
+
+	/**
+	 * How long a shot has been flying when the server fires it
+	 * A remote shot reaches the server about one way after it left the muzzle, and that same
+	 * delay is also why it is fired after its scheduled time, so the two are not added up
+	 * @param bCompensated - Shot from a lag-compensated (remote) shooter
+	 * @param ForwardSeconds - Flight time on the shooter's screen (ULagCompensationSubsystem::GetShotTiming)
+	 * @param SubFrameSeconds - Seconds between the shot's scheduled time and now
+	 */
+	static float GetShotFlightSeconds(bool bCompensated, float ForwardSeconds, float SubFrameSeconds);
+
+	/** Server time the weapon can fire again (predicted on the owning client) */
+	float GetNextFireTime() const { return NextFireTime; }
+
+	/**
+	 * Get current world time (server time or approximated client time)
+	 */
+	float GetWorldTime() const;
 
 	/**
 	 * Get current fire cooldown remaining time
@@ -80,6 +199,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	float GetFireCooldownRemaining() const;
 
+	/**
+	 * Calculate time between shots based on fire rate
+	 * @return Seconds between shots
+	 */
+	UFUNCTION(BlueprintPure, Category = "Weapon")
+	float GetFireCooldown() const;
+
 	// ========================================================================================
 	// Ammo System
 	// ========================================================================================
@@ -165,6 +291,41 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	EWeaponState GetWeaponState() const { return WeaponState; }
 
+	// ========================================================================================
+	// Client Prediction
+	// ========================================================================================
+
+	/**
+	 * Predict a shot on the owning client
+	 * Spends predicted ammo, starts the predicted cooldown (and auto-reload) and tags the shot with
+	 * the next prediction key; the server acknowledges it through OwnerState.LastShotKey
+	 * @param FireDirection - Normalized fire direction
+	 * @param ShotTime - Estimated server time the shot was scheduled for (< 0 = now)
+	 * @return True if the shot was predicted (the caller plays the local fire effects)
+	 */
+	bool PredictFire(const FVector& FireDirection, float ShotTime = -1.0f);
+
+	/**
+	 * Predict a reload start on the owning client (the finish is predicted from ReloadTime)
+	 * @return True if a reload was predicted
+	 */
+	bool PredictReload();
+
+	/** Drop every pending prediction and show the last server state (e.g. on death) */
+	void ClearPrediction();
+
+	/** Is this the owning client of a predicted weapon? */
+	bool IsPredictingLocally() const;
+
+	/** Prediction key the next shot will use (client: next predicted shot, server: next fired shot) */
+	uint8 GetNextShotKey() const { return NextShotKey; }
+
+	/**
+	 * Line the server's shot keys up with the client's (server, on trigger press)
+	 * @param InNextShotKey - Key the client gave its first predicted shot of the burst
+	 */
+	void SetNextShotKey(uint8 InNextShotKey) { NextShotKey = InNextShotKey; }
+
 	// ========================================================================================
 	// Configuration Properties
 	// ========================================================================================
@@ -173,6 +334,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Fire Rate", meta = (ClampMin = "1.0", ClampMax = "1200.0"))
 	float FireRate;
 
+	/** How far in the past (seconds) a shot may be scheduled: bounds client fire timestamps and frame catch-up */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Fire Rate", meta = (ClampMin = "0.0"))
+	float MaxFireTimeRewind;
+
 	/** Magazine capacity */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Ammo", meta = (ClampMin = "1"))
 	int32 MagazineSize;
@@ -201,44 +366,126 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Projectile")
 	FVector MuzzleOffset;
 
+	/** How fired projectiles are simulated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Projectile")
+	EProjectileSimulationMode ProjectileSimulationMode;
+
+	/** Maximum latency (seconds) clients fast-forward cosmetic projectiles by in ClientSimulated mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Projectile", meta = (ClampMin = "0.0"))
+	float MaxCosmeticFastForward;
+
+	/** Predict fire, ammo and reload on the owning client instead of waiting a round trip */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Prediction")
+	bool bClientPrediction;
+
+	/** Seconds a predicted shot or reload may go unacknowledged before it is treated as rejected */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Prediction", meta = (ClampMin = "0.05"))
+	float PredictionTimeout;
+
 protected:
 	// ========================================================================================
 	// Replicated State
 	// ========================================================================================
 
-	/** Current ammo in magazine (replicated) */
-	UPROPERTY(ReplicatedUsing = OnRep_CurrentAmmo, BlueprintReadOnly, Category = "Weapon|Ammo")
+	/** Current ammo in magazine (owner receives it through OwnerState) */
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Ammo")
 	int32 CurrentAmmo;
 
-	/** Reserve ammo available (replicated) */
-	UPROPERTY(ReplicatedUsing = OnRep_ReserveAmmo, BlueprintReadOnly, Category = "Weapon|Ammo")
+	/** Reserve ammo available (owner receives it through OwnerState) */
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Ammo")
 	int32 ReserveAmmo;
 
-	/** Current weapon state (replicated) */
+	/** Current weapon state (replicated to simulated proxies as 2 bits; owner receives it through OwnerState) */
 	UPROPERTY(ReplicatedUsing = OnRep_WeaponState, BlueprintReadOnly, Category = "Weapon")
 	EWeaponState WeaponState;
 
-	/** Server time when weapon can fire again */
-	UPROPERTY(Replicated)
+	/** Server time when weapon can fire again (owner receives it through OwnerState) */
 	float NextFireTime;
 
-	/** Server time when reload will complete */
-	UPROPERTY(Replicated)
+	/** Server time when reload will complete (owner receives it through OwnerState) */
 	float ReloadCompleteTime;
 
+	/** Prediction key of the last shot fired (server; the owner receives it through OwnerState) */
+	uint8 LastShotKey;
+
+	/** Packed copy of the fields above, replicated to the owning client only */
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerState)
+	FWeaponReplicatedState OwnerState;
+
 	// ========================================================================================
-	// Replication Callbacks
+	// Push Model Setters (all writes to replicated state go through these)
 	// ========================================================================================
 
-	UFUNCTION()
-	void OnRep_CurrentAmmo();
+	void SetCurrentAmmo(int32 NewCurrentAmmo);
+	void SetReserveAmmo(int32 NewReserveAmmo);
+	void SetWeaponState(EWeaponState NewWeaponState);
+	void SetNextFireTime(float NewNextFireTime);
+	void SetReloadCompleteTime(float NewReloadCompleteTime);
+	void SetLastShotKey(uint8 NewLastShotKey);
+
+	/** Record a dirty mark for the push-model stats */
+	void NotePushDirty(uint8 PropertyBit);
+
+	/** Re-pack OwnerState from the runtime fields and mark it dirty if anything changed */
+	void PackOwnerState();
+
+	/** Time the packed centisecond timestamps are relative to */
+	float GetMatchClockBase() const;
+
+	/** Convert a packed centisecond timestamp back to world time (0 stays "not set") */
+	float FromMatchCentiseconds(uint32 TimeCs) const;
+
+	/** Push-model properties marked dirty since the last PreReplication */
+	uint8 PushDirtyMask;
+
+	// ========================================================================================
+	// Replication Callbacks
+	// ========================================================================================
 
 	UFUNCTION()
-	void OnRep_ReserveAmmo();
+	void OnRep_OwnerState();
 
 	UFUNCTION()
 	void OnRep_WeaponState();
 
+	/**
+	 * Multicast RPC - Tell clients to simulate a cosmetic projectile (ClientSimulated mode)
+	 * @param FireEvent - Compact description of the shot
+	 */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileFired(const FProjectileFireEvent& FireEvent);
+	void MulticastProjectileFired_Implementation(const FProjectileFireEvent& FireEvent);
+
+	// ========================================================================================
+	// Prediction State (owning client)
+	// ========================================================================================
+
+	/** A predicted shot the server has not acknowledged yet */
+	struct FPredictedShot
+	{
+		uint8 Key;
+		float Time;
+	};
+
+	/** Predicted shots awaiting acknowledgement, oldest first */
+	TArray<FPredictedShot, TInlineAllocator<16>> PendingShots;
+
+	/** World time of a predicted reload the server has not started yet (0 = none) */
+	float PredictedReloadStartTime;
+
+	/** Next prediction key (client: next predicted shot; server: next fired shot) */
+	uint8 NextShotKey;
+
+	/** Re-runs reconciliation when a prediction times out or a reload is due to finish */
+	FTimerHandle ReconcileTimerHandle;
+
+	/**
+	 * Rebuild the visible weapon state from the last server state plus the predictions the
+	 * server has not acknowledged yet, and update the HUD for the fields that changed
+	 * (without pending predictions this just applies the replicated state)
+	 */
+	void ReconcilePrediction();
+
 	// ========================================================================================
 	// Internal Helper Functions
 	// ========================================================================================
@@ -250,18 +497,48 @@ protected:
 	void ConsumeAmmo();
 
 	/**
-	 * Calculate time between shots based on fire rate
-	 * @return Seconds between shots
+	 * Lag-compensate a shot and catch it up to the current frame (server only)
+	 * Sweeps the part of the flight path the shot has already covered (GetShotFlightSeconds; against
+	 * rewound targets for remote shooters), applying damage on a hit, otherwise moves the spawn
+	 * location forward along that path
+	 * @param InOutSpawnLocation - Muzzle location, advanced by the skipped flight time
+	 * @param FireDirection - Normalized fire direction
+	 * @param SubFrameSeconds - Seconds between the shot's scheduled time and now
+	 * @return True if the shot already hit something and no projectile should be launched
 	 */
-	float GetFireCooldown() const;
+	bool ResolveLagCompensatedShot(FVector& InOutSpawnLocation, const FVector& FireDirection, float SubFrameSeconds);
 
 	/**
-	 * Get current world time (server time or approximated client time)
+	 * Can the weapon fire a shot scheduled at this time?
+	 * @param ShotTime - Server time of the shot
 	 */
-	float GetWorldTime() const;
+	bool CanFireAt(float ShotTime) const;
+
+	/**
+	 * Launch a projectile using the configured simulation mode
+	 * Called on server only
+	 * @param SpawnLocation - Muzzle location
+	 * @param FireDirection - Normalized fire direction
+	 */
+	void LaunchProjectile(const FVector& SpawnLocation, const FVector& FireDirection);
+
+	/**
+	 * Spawn a local cosmetic projectile (ClientSimulated mode, clients only)
+	 * @param ArchetypeClass - Projectile class to simulate
+	 * @param Origin - Muzzle location
+	 * @param FireDirection - Normalized fire direction
+	 * @param Elapsed - Seconds of flight to skip (time spent on the wire)
+	 */
+	void SpawnCosmeticProjectile(TSubclassOf<AProjectile> ArchetypeClass, const FVector& Origin, const FVector& FireDirection, float Elapsed);
 
 	/**
 	 * Handle automatic reload when attempting to fire with empty magazine
 	 */
 	void HandleAutoReload();
+
+	/** Reload timer callback (server only) */
+	void OnReloadTimerElapsed();
+
+	/** Fires once when the current reload completes (server only) */
+	FTimerHandle ReloadTimerHandle;
 };
@@ -11,5 +11,8 @@ public class TopDownProtoEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("TopDownProto");
+
+		// Push model replication (see net.IsPushModelEnabled in DefaultEngine.ini)
+		bWithPushModel = true;
 	}
 }
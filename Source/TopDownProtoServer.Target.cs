@@ -11,8 +11,13 @@ public class TopDownProtoServerTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("TopDownProto");
+
+		// Push model replication (see net.IsPushModelEnabled in DefaultEngine.ini)
+		bWithPushModel = true;
 		
 		// Server optimizations
+		// Shipping servers keep logging so operators still get warnings and errors; per-shot combat lines
+		// are compiled out in shipping by LogTopDownCombat's compile-time verbosity (TopDownCombatLog.h)
 		bUseLoggingInShipping = true;
 		bCompileWithAccessibilitySupport = false;
 	}